@@ -31,4 +31,5 @@ project (workspaceName)
 	
 	link_raylib()
 	
-	-- To link to a lib use link_to("LIB_FOLDER_NAME")
\ No newline at end of file
+	-- To link to a lib use link_to("LIB_FOLDER_NAME")
+	link_to("simulation")
@@ -1,8 +1,16 @@
 /*******************************************************************************************
 *
-*   raylib [core] example - Storage save/load values
+*   IO Helper - Persistent leaderboard, kept in memory and written behind
 *
-*   Example originally created with raylib 1.4, last time updated with raylib 4.2
+*   Based on raylib [core] example - Storage save/load values
+*
+*   The leaderboard (see leaderboard.h) is opened once by InitStorage(). Saving a run only
+*   ranks it in the in-memory top and queues it, so a gameplay frame never reaches the
+*   filesystem: a flush thread appends queued runs to the log and rewrites the index.
+*   CloseStorage() flushes what is left.
+*
+*   The old storage file (two ints, time alive and score) is imported once as a single run
+*   when the leaderboard is still empty, it is left on disk untouched.
 *
 *   Example licensed under an unmodified zlib/libpng license, which is an OSI-certified,
 *   BSD-like license that allows static linking with closed source software
@@ -13,108 +21,162 @@
 
 #include "raylib.h"
 #include "screens.h"
-#include <stdlib.h>         // Required for: calloc(), free()
-
-#define STORAGE_DATA_FILE   "highScores.data"   // Storage file
-
-// NOTE: Storage positions must start with 0, directly related to file memory layout
+#include "simulation.h"     // Required for: SIM_TICKS_PER_SECOND
+#include "memory_tracker.h"
+#include <string.h>         // Required for: memcpy()
+#include <time.h>           // Required for: time()
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define LEADERBOARD_BASE_FILE   "leaderboard"       // leaderboard.runs and leaderboard.index
+#define LEGACY_STORAGE_FILE     "highScores.data"   // Imported once, see InitStorage()
+#define PENDING_RUNS_MAX        64                  // Game overs are seconds apart, the queue is drained long before
+
+// NOTE: Legacy storage positions, directly related to the old file memory layout
 typedef enum {
     STORAGE_POSITION_HITIME = 0,
     STORAGE_POSITION_HISCORE = 1
 } StorageData;
 
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static Leaderboard board = { 0 };       // Only touched by the flush thread once it runs
+static bool isBoardOpen = false;
+static LeaderboardTop displayTop = { 0 };   // Board top plus the runs still queued
+static int lastRunRank = -1;
+static LeaderboardRun pendingRuns[PENDING_RUNS_MAX] = { 0 };
+static int pendingCount = 0;
+static bool isStorageClosing = false;
+static std::mutex storageMutex;
+static std::condition_variable storageChanged;
+static std::thread storageFlusher;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Best time and best score of the old file become one run, they may come from two different games
+static void importLegacyStorage(void)
+{
+    int dataSize = 0;
+    unsigned char *fileData = LoadFileData(LEGACY_STORAGE_FILE, &dataSize);
+    if (fileData == NULL) return;
+
+    int values[2] = { 0 };
+    if (dataSize >= (int)sizeof(values)) memcpy(values, fileData, sizeof(values));
+    UnloadFileData(fileData);
+
+    LeaderboardRun run = { 0 };
+    run.score = values[STORAGE_POSITION_HISCORE];
+    run.ticks = (unsigned int)values[STORAGE_POSITION_HITIME]*SIM_TICKS_PER_SECOND;
+    run.date = (int64_t)GetFileModTime(LEGACY_STORAGE_FILE);
+    run.flags = LEADERBOARD_RUN_IMPORTED;
+
+    if ((run.score <= 0) && (run.ticks == 0)) return;
 
+    if (AppendLeaderboardRuns(&board, &run, 1)) TraceLog(LOG_INFO, "FILEIO: [%s] Imported into the leaderboard", LEGACY_STORAGE_FILE);
+    else TraceLog(LOG_WARNING, "FILEIO: [%s] Could not be imported into the leaderboard", LEGACY_STORAGE_FILE);
+}
 
-// Save integer value to storage file (to defined position)
-// NOTE: Storage positions is directly related to file memory layout (4 bytes each integer)
-bool SaveStorageValue(unsigned int position, int value)
+static void runStorageFlusher(void)
 {
-    bool success = false;
-    unsigned int dataSize = 0;
-    unsigned int newDataSize = 0;
-    unsigned char* fileData = LoadFileData(STORAGE_DATA_FILE, (int*) & dataSize);
-    unsigned char* newFileData = NULL;
+    MEMORY_TAG_SCOPE(MEMORY_TAG_FILE_IO);
+    std::unique_lock<std::mutex> lock(storageMutex);
 
-    if (fileData != NULL)
+    while (true)
     {
-        if (dataSize <= (position * sizeof(int)))
-        {
-            // Increase data size up to position and store value
-            newDataSize = (position + 1) * sizeof(int);
-            newFileData = (unsigned char*)RL_REALLOC(fileData, newDataSize);
-
-            if (newFileData != NULL)
-            {
-                // RL_REALLOC succeded
-                int* dataPtr = (int*)newFileData;
-                dataPtr[position] = value;
-            }
-            else
-            {
-                // RL_REALLOC failed
-                TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to realloc data (%u), position in bytes (%u) bigger than actual file size", STORAGE_DATA_FILE, dataSize, position * sizeof(int));
-
-                // We store the old size of the file
-                newFileData = fileData;
-                newDataSize = dataSize;
-            }
-        }
-        else
-        {
-            // Store the old size of the file
-            newFileData = fileData;
-            newDataSize = dataSize;
-
-            // Replace value on selected position
-            int* dataPtr = (int*)newFileData;
-            dataPtr[position] = value;
-        }
-
-        success = SaveFileData(STORAGE_DATA_FILE, newFileData, newDataSize);
-        RL_FREE(newFileData);
-
-        TraceLog(LOG_INFO, "FILEIO: [%s] Saved storage value: %i", STORAGE_DATA_FILE, value);
+        storageChanged.wait(lock, [] { return (pendingCount > 0) || isStorageClosing; });
+        if (pendingCount == 0) break;
+
+        LeaderboardRun runs[PENDING_RUNS_MAX];
+        int count = pendingCount;
+        memcpy(runs, pendingRuns, count*sizeof(LeaderboardRun));
+        pendingCount = 0;
+
+        // Runs keep being ranked in memory while the files are written
+        lock.unlock();
+        bool success = AppendLeaderboardRuns(&board, runs, count);
+        lock.lock();
+
+        if (success) TraceLog(LOG_INFO, "FILEIO: [%s] Saved %i runs, %llu recorded", board.runsFileName, count, (unsigned long long)board.top.runCount);
+        else TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to save %i runs", board.runsFileName, count);
     }
-    else
+}
+
+//----------------------------------------------------------------------------------
+// Storage Functions Definition
+//----------------------------------------------------------------------------------
+
+// Open the leaderboard and start the flush thread
+void InitStorage(void)
+{
+    MEMORY_TAG_SCOPE(MEMORY_TAG_FILE_IO);
+
+    isBoardOpen = OpenLeaderboard(&board, LEADERBOARD_BASE_FILE);
+
+    if (!isBoardOpen) TraceLog(LOG_WARNING, "FILEIO: [%s] Not a leaderboard, runs of this session are not saved", board.runsFileName);
+    else if (board.top.runCount == 0) importLegacyStorage();
+
     {
-        TraceLog(LOG_INFO, "FILEIO: [%s] File created successfully", STORAGE_DATA_FILE);
+        std::lock_guard<std::mutex> lock(storageMutex);
 
-        dataSize = (position + 1) * sizeof(int);
-        fileData = (unsigned char*)RL_MALLOC(dataSize);
-        int* dataPtr = (int*)fileData;
-        dataPtr[position] = value;
+        displayTop = board.top;
+        lastRunRank = -1;
+        pendingCount = 0;
+        isStorageClosing = false;
+    }
 
-        success = SaveFileData(STORAGE_DATA_FILE, fileData, dataSize);
-        UnloadFileData(fileData);
+    if (isBoardOpen) storageFlusher = std::thread(runStorageFlusher);
+}
 
-        TraceLog(LOG_INFO, "FILEIO: [%s] Saved storage value: %i", STORAGE_DATA_FILE, value);
+// Write pending runs and stop the flush thread
+void CloseStorage(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        isStorageClosing = true;
     }
+    storageChanged.notify_one();
 
-    return success;
+    if (storageFlusher.joinable()) storageFlusher.join();
 }
 
-// Load integer value from storage file (from defined position)
-// NOTE: If requested position could not be found, value 0 is returned
-int LoadStorageValue(unsigned int position)
+// Rank a finished run and queue it, written to the leaderboard in the background
+// NOTE: Returns the run rank in the top (0 based), -1 if it did not make it
+int SaveLeaderboardRun(int score, unsigned int ticks, uint64_t seed)
 {
-    int value = 0;
-    unsigned int dataSize = 0;
-    unsigned char* fileData = LoadFileData(STORAGE_DATA_FILE, (int*)&dataSize);
+    LeaderboardRun run = { score, ticks, seed, (int64_t)time(NULL), 0 };
 
-    if (fileData != NULL)
     {
-        if (dataSize < (position * 4)) TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to find storage position: %i", STORAGE_DATA_FILE, position);
-        else
-        {
-            int* dataPtr = (int*)fileData;
-            value = dataPtr[position];
-        }
+        std::lock_guard<std::mutex> lock(storageMutex);
+
+        lastRunRank = AddLeaderboardEntry(&displayTop, { run.score, run.ticks, run.date, displayTop.runCount });
+        displayTop.runCount++;
 
-        UnloadFileData(fileData);
+        if (!isBoardOpen) return lastRunRank;
 
-        TraceLog(LOG_INFO, "FILEIO: [%s] Loaded storage value: %i", STORAGE_DATA_FILE, value);
+        if (pendingCount < PENDING_RUNS_MAX) pendingRuns[pendingCount++] = run;
+        else TraceLog(LOG_WARNING, "FILEIO: [%s] Save queue full, run not saved", board.runsFileName);
     }
+    storageChanged.notify_one();
 
-    return value;
+    return lastRunRank;
+}
+
+// Copy of the current top, runs not written yet included
+LeaderboardTop GetLeaderboardTop(void)
+{
+    std::lock_guard<std::mutex> lock(storageMutex);
+
+    return displayTop;
+}
+
+// Rank of the last run saved this session, -1 if none or outside the top
+int GetLastLeaderboardRank(void)
+{
+    std::lock_guard<std::mutex> lock(storageMutex);
 
-}
\ No newline at end of file
+    return lastRunRank;
+}
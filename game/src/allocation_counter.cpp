@@ -0,0 +1,78 @@
+/**********************************************************************************************
+*
+*   Allocation Counter - Counts heap allocations done through operator new
+*
+**********************************************************************************************/
+
+#include "allocation_counter.h"
+#include <stdlib.h>         // Required for: malloc(), free()
+#include <atomic>
+#include <new>
+
+#if defined(COUNT_HEAP_ALLOCATIONS)
+
+#if defined(TRACK_MEMORY)
+    #define COUNTED_MALLOC(size) TrackedMalloc(size)
+    #define COUNTED_FREE(ptr) TrackedFree(ptr)
+#else
+    #define COUNTED_MALLOC(size) malloc(size)
+    #define COUNTED_FREE(ptr) free(ptr)
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static std::atomic<unsigned long long> heapAllocations(0);
+
+//----------------------------------------------------------------------------------
+// Global operator new/delete replacements
+// NOTE: Every STL container in the program goes through these
+//----------------------------------------------------------------------------------
+void *operator new(size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    void *ptr = COUNTED_MALLOC((size > 0)? size : 1);
+    if (ptr == NULL) throw std::bad_alloc();
+
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    COUNTED_FREE(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    COUNTED_FREE(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    COUNTED_FREE(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    COUNTED_FREE(ptr);
+}
+
+unsigned long long GetHeapAllocationCount(void)
+{
+    return heapAllocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+unsigned long long GetHeapAllocationCount(void)
+{
+    return 0;
+}
+
+#endif // COUNT_HEAP_ALLOCATIONS
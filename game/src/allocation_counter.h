@@ -0,0 +1,26 @@
+/**********************************************************************************************
+*
+*   Allocation Counter - Counts heap allocations done through operator new
+*
+*   Enabled with COUNT_HEAP_ALLOCATIONS, on by default in debug builds. Gameplay uses it to
+*   check that frames at steady state do not allocate, headless always compiles it in and
+*   fails its runs when a simulation tick allocates after warmup. With TRACK_MEMORY the
+*   replaced operators also charge every block to the memory tracker (see memory_tracker.h).
+*
+**********************************************************************************************/
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include "memory_hooks.h"           // Required for: TRACK_MEMORY
+
+#if (defined(DEBUG) || defined(TRACK_MEMORY)) && !defined(COUNT_HEAP_ALLOCATIONS)
+    #define COUNT_HEAP_ALLOCATIONS
+#endif
+
+//----------------------------------------------------------------------------------
+// Allocation Counter Functions Declaration
+//----------------------------------------------------------------------------------
+unsigned long long GetHeapAllocationCount(void);    // Total allocations so far, 0 if counting is disabled
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,448 @@
+/**********************************************************************************************
+*
+*   Asset Cache - Reference-counted textures, sounds and music streams keyed by file path
+*
+**********************************************************************************************/
+
+#include "asset_cache.h"
+#include "memory_tracker.h"
+#include <string.h>                 // Required for: strcmp()
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#define ASSET_LOADER_THREADS 2      // Decoding is file bound, more workers barely help
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum AssetType { ASSET_TEXTURE = 0, ASSET_SOUND, ASSET_MUSIC } AssetType;
+
+typedef struct CachedAsset {
+    std::string fileName;
+    AssetType type;
+    Texture2D texture;
+    Sound sound;
+    Music music;
+    unsigned char *musicData;       // File contents a preloaded music stream decodes from
+    int refCount;
+    unsigned long long lastUse;     // Value of useCounter when last acquired or released
+    unsigned int sizeBytes;         // Decoded size, compressed file size for streamed music
+} CachedAsset;
+
+// Preload request, decoded on a worker thread and uploaded on the main thread
+typedef struct LoadJob {
+    std::string fileName;
+    AssetType type;
+    Image image;
+    Wave wave;
+    unsigned char *fileData;
+    int dataSize;
+    std::atomic<bool> isDecoded;
+} LoadJob;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+// A few dozen entries at most, linear scans beat hashing here
+static std::vector<CachedAsset> assets;
+static unsigned int budget = 0;
+static unsigned int residentBytes = 0;
+static unsigned long long useCounter = 0;
+
+static std::vector<LoadJob *> pendingJobs;      // Main thread only, in request order
+static std::deque<LoadJob *> jobQueue;          // Shared with the workers, guarded by jobMutex
+static std::mutex jobMutex;
+static std::condition_variable jobQueued;
+static std::condition_variable jobDecoded;
+static std::vector<std::thread> workers;
+static bool isShuttingDown = false;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static CachedAsset *findAsset(AssetType type, const char *fileName)
+{
+    for (CachedAsset &asset : assets)
+    {
+        if ((asset.type == type) && (strcmp(asset.fileName.c_str(), fileName) == 0)) return &asset;
+    }
+
+    return NULL;
+}
+
+static int findPendingJob(AssetType type, const char *fileName)
+{
+    for (int i = 0; i < (int)pendingJobs.size(); i++)
+    {
+        if ((pendingJobs[i]->type == type) && (strcmp(pendingJobs[i]->fileName.c_str(), fileName) == 0)) return i;
+    }
+
+    return -1;
+}
+
+static void unloadAsset(CachedAsset &asset)
+{
+    switch (asset.type)
+    {
+        case ASSET_TEXTURE: UnloadTexture(asset.texture); break;
+        case ASSET_SOUND: UnloadSound(asset.sound); break;
+        case ASSET_MUSIC:
+        {
+            UnloadMusicStream(asset.music);
+            if (asset.musicData != NULL) MemFree(asset.musicData);
+        } break;
+        default: break;
+    }
+
+    residentBytes -= asset.sizeBytes;
+}
+
+// Evicts unreferenced assets, least recently used first, until the budget is met
+static void trimAssetCache(void)
+{
+    while ((budget > 0) && (residentBytes > budget))
+    {
+        int victim = -1;
+
+        for (int i = 0; i < (int)assets.size(); i++)
+        {
+            if ((assets[i].refCount == 0) && ((victim == -1) || (assets[i].lastUse < assets[victim].lastUse))) victim = i;
+        }
+
+        if (victim == -1) break;    // Everything left is in use
+
+        TraceLog(LOG_INFO, "ASSETS: [%s] Evicted (%u KB)", assets[victim].fileName.c_str(), assets[victim].sizeBytes/1024);
+        unloadAsset(assets[victim]);
+        assets.erase(assets.begin() + victim);
+    }
+}
+
+static CachedAsset *addAsset(const CachedAsset &loaded)
+{
+    residentBytes += loaded.sizeBytes;
+    assets.push_back(loaded);
+
+    TraceLog(LOG_INFO, "ASSETS: [%s] Cached (%u KB), resident %u KB", loaded.fileName.c_str(), loaded.sizeBytes/1024, residentBytes/1024);
+
+    return &assets.back();
+}
+
+// Worker side: everything that only touches memory and files
+static void decodeJob(LoadJob *job)
+{
+    switch (job->type)
+    {
+        case ASSET_TEXTURE:
+        {
+            MEMORY_TAG_SCOPE(MEMORY_TAG_TEXTURES);
+            job->image = LoadImage(job->fileName.c_str());
+        } break;
+        case ASSET_SOUND:
+        {
+            MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+            job->wave = LoadWave(job->fileName.c_str());
+        } break;
+        case ASSET_MUSIC:
+        {
+            MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);     // Kept by the stream, decoded from while it plays
+            job->fileData = LoadFileData(job->fileName.c_str(), &job->dataSize);
+        } break;
+        default: break;
+    }
+}
+
+static void loaderThread(void)
+{
+    while (true)
+    {
+        LoadJob *job = NULL;
+
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobQueued.wait(lock, []{ return isShuttingDown || !jobQueue.empty(); });
+
+            if (isShuttingDown) return;
+
+            job = jobQueue.front();
+            jobQueue.pop_front();
+        }
+
+        decodeJob(job);
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            job->isDecoded = true;
+        }
+        jobDecoded.notify_all();
+    }
+}
+
+// Main thread side: GPU and audio device uploads, frees the job
+static CachedAsset *finishJob(int index)
+{
+    LoadJob *job = pendingJobs[index];
+    pendingJobs.erase(pendingJobs.begin() + index);
+
+    CachedAsset loaded = { };
+    loaded.fileName = job->fileName;
+    loaded.type = job->type;
+    loaded.lastUse = ++useCounter;
+    bool isValid = false;
+
+    switch (job->type)
+    {
+        case ASSET_TEXTURE:
+        {
+            MEMORY_TAG_SCOPE(MEMORY_TAG_TEXTURES);
+            if (job->image.data != NULL)
+            {
+                loaded.texture = LoadTextureFromImage(job->image);
+                loaded.sizeBytes = GetPixelDataSize(loaded.texture.width, loaded.texture.height, loaded.texture.format);
+                isValid = (loaded.texture.id != 0);
+            }
+            UnloadImage(job->image);
+        } break;
+        case ASSET_SOUND:
+        {
+            MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+            if (job->wave.data != NULL)
+            {
+                loaded.sound = LoadSoundFromWave(job->wave);
+                loaded.sizeBytes = loaded.sound.frameCount*loaded.sound.stream.channels*loaded.sound.stream.sampleSize/8;
+                isValid = (loaded.sound.stream.buffer != NULL);
+            }
+            UnloadWave(job->wave);
+        } break;
+        case ASSET_MUSIC:
+        {
+            MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+
+            // The stream keeps decoding from this buffer, so it lives as long as the asset
+            if (job->fileData != NULL) loaded.music = LoadMusicStreamFromMemory(GetFileExtension(job->fileName.c_str()), job->fileData, job->dataSize);
+            isValid = (loaded.music.ctxData != NULL);
+
+            if (isValid)
+            {
+                loaded.musicData = job->fileData;
+                loaded.sizeBytes = job->dataSize;
+            }
+            else if (job->fileData != NULL) MemFree(job->fileData);
+        } break;
+        default: break;
+    }
+
+    delete job;
+
+    return isValid? addAsset(loaded) : NULL;
+}
+
+static CachedAsset *acquireAsset(AssetType type, const char *fileName)
+{
+    CachedAsset *asset = findAsset(type, fileName);
+
+    // Still in flight: wait for the worker instead of decoding the same file twice
+    int jobIndex = (asset == NULL)? findPendingJob(type, fileName) : -1;
+    if (jobIndex != -1)
+    {
+        LoadJob *job = pendingJobs[jobIndex];
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobDecoded.wait(lock, [job]{ return job->isDecoded.load(); });
+        lock.unlock();
+
+        asset = finishJob(jobIndex);
+    }
+
+    if (asset == NULL)
+    {
+        CachedAsset loaded = { };
+        loaded.fileName = fileName;
+        loaded.type = type;
+
+        switch (type)
+        {
+            case ASSET_TEXTURE:
+            {
+                MEMORY_TAG_SCOPE(MEMORY_TAG_TEXTURES);
+                loaded.texture = LoadTexture(fileName);
+                if (loaded.texture.id == 0) return NULL;
+                loaded.sizeBytes = GetPixelDataSize(loaded.texture.width, loaded.texture.height, loaded.texture.format);
+            } break;
+            case ASSET_SOUND:
+            {
+                MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+                loaded.sound = LoadSound(fileName);
+                if (loaded.sound.stream.buffer == NULL) return NULL;
+                loaded.sizeBytes = loaded.sound.frameCount*loaded.sound.stream.channels*loaded.sound.stream.sampleSize/8;
+            } break;
+            case ASSET_MUSIC:
+            {
+                MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+                loaded.music = LoadMusicStream(fileName);
+                if (loaded.music.ctxData == NULL) return NULL;
+                loaded.sizeBytes = GetFileLength(fileName);
+            } break;
+            default: break;
+        }
+
+        asset = addAsset(loaded);
+    }
+
+    asset->refCount++;
+    asset->lastUse = ++useCounter;
+
+    return asset;
+}
+
+static void releaseAsset(CachedAsset *asset)
+{
+    if (asset == NULL) return;
+
+    if (asset->refCount > 0) asset->refCount--;
+    asset->lastUse = ++useCounter;
+
+    // A stream left playing would keep looping its last buffer once nobody updates it
+    if ((asset->refCount == 0) && (asset->type == ASSET_MUSIC)) StopMusicStream(asset->music);
+
+    trimAssetCache();
+}
+
+static void preloadAsset(AssetType type, const char *fileName)
+{
+    if ((findAsset(type, fileName) != NULL) || (findPendingJob(type, fileName) != -1)) return;
+
+    LoadJob *job = new LoadJob();
+    job->fileName = fileName;
+    job->type = type;
+    job->image = Image{ 0 };
+    job->wave = Wave{ 0 };
+    job->fileData = NULL;
+    job->dataSize = 0;
+    job->isDecoded = false;
+
+    pendingJobs.push_back(job);
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobQueue.push_back(job);
+    }
+    jobQueued.notify_one();
+}
+
+//----------------------------------------------------------------------------------
+// Asset Cache Functions Definition
+//----------------------------------------------------------------------------------
+void InitAssetCache(unsigned int budgetBytes)
+{
+    budget = budgetBytes;
+    residentBytes = 0;
+    useCounter = 0;
+    assets.clear();
+    assets.reserve(32);
+
+    isShuttingDown = false;
+    for (int i = 0; i < ASSET_LOADER_THREADS; i++) workers.emplace_back(loaderThread);
+}
+
+void UpdateAssetCache(double uploadBudgetSeconds)
+{
+    double startTime = GetTime();
+
+    // Uploads in request order, at least one per frame so loading always progresses
+    for (int i = 0; i < (int)pendingJobs.size(); )
+    {
+        if (!pendingJobs[i]->isDecoded) { i++; continue; }
+
+        finishJob(i);
+
+        if ((GetTime() - startTime) > uploadBudgetSeconds) break;
+    }
+
+    trimAssetCache();
+}
+
+void UnloadAssetCache(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        isShuttingDown = true;
+    }
+    jobQueued.notify_all();
+
+    for (std::thread &worker : workers) worker.join();
+    workers.clear();
+    jobQueue.clear();
+
+    // Workers are gone, leftover jobs are either untouched or fully decoded
+    for (LoadJob *job : pendingJobs)
+    {
+        UnloadImage(job->image);
+        UnloadWave(job->wave);
+        if (job->fileData != NULL) MemFree(job->fileData);
+        delete job;
+    }
+    pendingJobs.clear();
+
+    for (CachedAsset &asset : assets)
+    {
+        if (asset.refCount > 0) TraceLog(LOG_WARNING, "ASSETS: [%s] Still referenced %i times at shutdown", asset.fileName.c_str(), asset.refCount);
+        unloadAsset(asset);
+    }
+
+    assets.clear();
+}
+
+void PreloadTexture(const char *fileName) { preloadAsset(ASSET_TEXTURE, fileName); }
+void PreloadSound(const char *fileName) { preloadAsset(ASSET_SOUND, fileName); }
+void PreloadMusic(const char *fileName) { preloadAsset(ASSET_MUSIC, fileName); }
+
+bool IsAssetCacheLoading(void)
+{
+    return !pendingJobs.empty();
+}
+
+Texture2D AcquireTexture(const char *fileName)
+{
+    CachedAsset *asset = acquireAsset(ASSET_TEXTURE, fileName);
+    return (asset != NULL)? asset->texture : Texture2D{ 0 };
+}
+
+Sound AcquireSound(const char *fileName)
+{
+    CachedAsset *asset = acquireAsset(ASSET_SOUND, fileName);
+    return (asset != NULL)? asset->sound : Sound{ 0 };
+}
+
+Music AcquireMusic(const char *fileName)
+{
+    CachedAsset *asset = acquireAsset(ASSET_MUSIC, fileName);
+    return (asset != NULL)? asset->music : Music{ 0 };
+}
+
+void ReleaseTexture(Texture2D texture)
+{
+    for (CachedAsset &asset : assets)
+    {
+        if ((asset.type == ASSET_TEXTURE) && (asset.texture.id == texture.id)) { releaseAsset(&asset); return; }
+    }
+}
+
+void ReleaseSound(Sound sound)
+{
+    for (CachedAsset &asset : assets)
+    {
+        if ((asset.type == ASSET_SOUND) && (asset.sound.stream.buffer == sound.stream.buffer)) { releaseAsset(&asset); return; }
+    }
+}
+
+void ReleaseMusic(Music music)
+{
+    for (CachedAsset &asset : assets)
+    {
+        if ((asset.type == ASSET_MUSIC) && (asset.music.ctxData == music.ctxData)) { releaseAsset(&asset); return; }
+    }
+}
@@ -0,0 +1,41 @@
+/**********************************************************************************************
+*
+*   Asset Cache - Reference-counted textures, sounds and music streams keyed by file path
+*
+*   Screens acquire assets in Init*Screen() and release them in Unload*Screen(), the same
+*   way they used Load*()/Unload*(). Released assets stay resident, so coming back to a
+*   screen does not decode anything again. When the resident size goes over the budget,
+*   unreferenced assets are evicted least recently used first.
+*
+*   Preload*() queues an asset for worker threads that read and decode the file. Only the
+*   GPU and audio uploads run on the main thread, in UpdateAssetCache(), within a time
+*   budget per frame. Acquiring an asset that is still in flight waits for its worker.
+*
+**********************************************************************************************/
+
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Asset Cache Functions Declaration
+//----------------------------------------------------------------------------------
+void InitAssetCache(unsigned int budgetBytes);      // 0 means no budget, released assets are never evicted
+void UnloadAssetCache(void);                        // Unloads every asset, referenced or not
+void UpdateAssetCache(double uploadBudgetSeconds);  // Uploads decoded preloads, call once per frame
+bool IsAssetCacheLoading(void);                     // Preloads still decoding or waiting for upload
+
+void PreloadTexture(const char *fileName);          // Decoded in the background, cached unreferenced
+void PreloadSound(const char *fileName);
+void PreloadMusic(const char *fileName);
+
+Texture2D AcquireTexture(const char *fileName);     // Loads on first use, then shares the same texture
+Sound AcquireSound(const char *fileName);
+Music AcquireMusic(const char *fileName);           // Stopped when released, play again from the start
+
+void ReleaseTexture(Texture2D texture);
+void ReleaseSound(Sound sound);
+void ReleaseMusic(Music music);
+
+#endif // ASSET_CACHE_H
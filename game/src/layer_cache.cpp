@@ -0,0 +1,59 @@
+/**********************************************************************************************
+*
+*   Layer Cache - Static screen content rendered once into a render texture
+*
+**********************************************************************************************/
+
+#include "layer_cache.h"
+#include "rlgl.h"                   // Required for: rlSetBlendFactors()
+
+//----------------------------------------------------------------------------------
+// Layer Cache Functions Definition
+//----------------------------------------------------------------------------------
+void DrawLayerCache(LayerCache *layer, unsigned int key, void (*drawLayer)(void))
+{
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+
+    if ((layer->target.id == 0) || (layer->target.texture.width != width) || (layer->target.texture.height != height))
+    {
+        UnloadLayerCache(layer);
+        layer->target = LoadRenderTexture(width, height);
+    }
+
+    if (!layer->isValid || (layer->key != key))
+    {
+        // Texture mode is allowed mid frame, the batch is flushed and the screen target restored after
+        BeginTextureMode(layer->target);
+            ClearBackground(BLANK);
+            drawLayer();
+        EndTextureMode();
+
+        layer->key = key;
+        layer->isValid = true;
+    }
+
+    // Alpha blending inside the texture leaves partial alpha around text edges, copying
+    // the opaque layer as is avoids blending those edges a second time with the screen
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+
+    // Render textures are stored upside down
+    Rectangle source = { 0.0f, 0.0f, (float)layer->target.texture.width, -(float)layer->target.texture.height };
+    DrawTextureRec(layer->target.texture, source, { 0.0f, 0.0f }, WHITE);
+
+    EndBlendMode();
+}
+
+void InvalidateLayerCache(LayerCache *layer)
+{
+    layer->isValid = false;
+}
+
+void UnloadLayerCache(LayerCache *layer)
+{
+    if (layer->target.id != 0) UnloadRenderTexture(layer->target);
+
+    layer->target = { 0 };
+    layer->isValid = false;
+}
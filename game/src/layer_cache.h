@@ -0,0 +1,38 @@
+/**********************************************************************************************
+*
+*   Layer Cache - Static screen content rendered once into a render texture
+*
+*   A menu screen is mostly a full-screen background and a few lines of text that never
+*   move. DrawLayerCache() renders such content into a screen-sized RenderTexture2D the
+*   first time, then only composites that texture: one quad instead of a background blit
+*   and a text run per line, every frame. The layer is rendered again when the window
+*   size changes or when the key changes; the key packs whatever the content depends on
+*   (volume level, high scores, menu state), 0 for content that never changes.
+*
+*   Layers are opaque (they start with the background), they replace what was drawn
+*   below them instead of blending over it. Animated elements are drawn after them.
+*
+**********************************************************************************************/
+
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct LayerCache {
+    RenderTexture2D target;         // Screen size, id 0 until first drawn
+    unsigned int key;               // Key the current content was rendered with
+    bool isValid;
+} LayerCache;
+
+//----------------------------------------------------------------------------------
+// Layer Cache Functions Declaration
+//----------------------------------------------------------------------------------
+void DrawLayerCache(LayerCache *layer, unsigned int key, void (*drawLayer)(void));     // Renders again if the key or the window size changed
+void InvalidateLayerCache(LayerCache *layer);                                          // Next draw renders again
+void UnloadLayerCache(LayerCache *layer);
+
+#endif // LAYER_CACHE_H
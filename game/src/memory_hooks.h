@@ -0,0 +1,61 @@
+/**********************************************************************************************
+*
+*   Memory Hooks - Routes raylib heap allocations to the memory tracker
+*
+*   Force-included into every raylib source (see raylib_premake5.lua), so RL_MALLOC,
+*   RL_CALLOC, RL_REALLOC and RL_FREE, and the libraries raylib configures with them, are
+*   defined before raylib.h and rlgl.h provide their malloc() defaults. stb_truetype and
+*   miniaudio realloc are not routed through RL_* by raylib, their bitmaps and buffers are
+*   later freed with RL_FREE, so they are hooked here too.
+*
+*   Every block freed or resized through the hooks must have been allocated by them: the
+*   tracker reads its header in front of the pointer and asserts on anything else, so a
+*   plain malloc() paired with RL_FREE (or the reverse) is a bug to fix at the call site.
+*
+*   Plain C, only hook declarations. Compiled in with TRACK_MEMORY (on by default in debug
+*   builds, premake --memory for release), otherwise this header defines nothing. Targets
+*   that do not link the tracker (headless) define DISABLE_MEMORY_TRACKER to turn it off.
+*
+**********************************************************************************************/
+
+#ifndef MEMORY_HOOKS_H
+#define MEMORY_HOOKS_H
+
+#if defined(DISABLE_MEMORY_TRACKER)
+    #undef TRACK_MEMORY
+#elif defined(DEBUG) && !defined(TRACK_MEMORY)
+    #define TRACK_MEMORY
+#endif
+
+#if defined(TRACK_MEMORY)
+
+#include <stddef.h>                 // Required for: size_t
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *TrackedMalloc(size_t size);                   // Charged to the calling thread tag, see memory_tracker.h
+void *TrackedCalloc(size_t count, size_t size);
+void *TrackedRealloc(void *ptr, size_t size);       // Stays charged to the tag it was allocated with
+void TrackedFree(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+// NOTE: Game sources include raylib.h first and keep its defaults, they never call RL_* directly
+#if !defined(RL_MALLOC)
+    #define RL_MALLOC(sz)           TrackedMalloc(sz)
+    #define RL_CALLOC(n,sz)         TrackedCalloc(n,sz)
+    #define RL_REALLOC(ptr,sz)      TrackedRealloc(ptr,sz)
+    #define RL_FREE(ptr)            TrackedFree(ptr)
+
+    #define STBTT_malloc(x,u)       ((void)(u),TrackedMalloc(x))
+    #define STBTT_free(x,u)         ((void)(u),TrackedFree(x))
+    #define MA_REALLOC(p,sz)        TrackedRealloc(p,sz)
+#endif
+
+#endif // TRACK_MEMORY
+
+#endif // MEMORY_HOOKS_H
@@ -0,0 +1,225 @@
+/**********************************************************************************************
+*
+*   Memory Tracker - Heap usage per subsystem, for raylib and the game alike
+*
+**********************************************************************************************/
+
+#include "memory_tracker.h"
+
+#if defined(TRACK_MEMORY)
+
+#include "raylib.h"
+#include <stdlib.h>                 // Required for: malloc(), realloc(), free()
+#include <string.h>                 // Required for: memset()
+#include <stdint.h>
+#include <assert.h>                 // Required for: assert()
+#include <atomic>
+
+#define MEMORY_BLOCK_MAGIC 0x4d454d54u      // "MEMT", cleared on free to catch double frees
+#define MEMORY_OVERLAY_KEY KEY_F6         // F3/F4 profiler, F5/F9 gameplay checkpoints
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// In front of every tracked block, 16 bytes keep malloc() alignment
+typedef struct MemoryBlockHeader {
+    uint64_t size;
+    uint32_t tag;
+    uint32_t magic;
+} MemoryBlockHeader;
+
+typedef struct MemoryCounters {
+    std::atomic<long long> liveCount;
+    std::atomic<long long> liveBytes;
+    std::atomic<long long> peakBytes;
+    std::atomic<long long> highWaterBytes;
+    std::atomic<unsigned long long> allocations;
+} MemoryCounters;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+
+// NOTE: Zero initialized before any constructor runs, static initializers may allocate
+static MemoryCounters counters[MEMORY_TAG_COUNT];
+static thread_local MemoryTag currentTag = MEMORY_TAG_OTHER;
+static bool isOverlayVisible = false;
+
+static const char *tagNames[MEMORY_TAG_COUNT] = { "other", "textures", "audio", "fonts", "gameplay", "file io" };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static void raiseToAtLeast(std::atomic<long long> &mark, long long value)
+{
+    long long current = mark.load(std::memory_order_relaxed);
+    while ((value > current) && !mark.compare_exchange_weak(current, value, std::memory_order_relaxed)) { }
+}
+
+static void chargeBlock(MemoryTag tag, long long size)
+{
+    MemoryCounters &tagCounters = counters[tag];
+
+    tagCounters.liveCount.fetch_add(1, std::memory_order_relaxed);
+    tagCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+    long long liveBytes = tagCounters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    raiseToAtLeast(tagCounters.peakBytes, liveBytes);
+    raiseToAtLeast(tagCounters.highWaterBytes, liveBytes);
+}
+
+static void dischargeBlock(MemoryTag tag, long long size)
+{
+    counters[tag].liveCount.fetch_sub(1, std::memory_order_relaxed);
+    counters[tag].liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+// NOTE: Every block reaching the hooks must come from them (see memory_hooks.h), ownership is
+// never guessed from memory contents, the magic only asserts that contract in debug builds
+static MemoryBlockHeader *getBlockHeader(void *ptr)
+{
+    MemoryBlockHeader *header = (MemoryBlockHeader *)ptr - 1;
+    assert((header->magic == MEMORY_BLOCK_MAGIC) && "Block not allocated by the memory hooks, or already freed");
+
+    return header;
+}
+
+static void *startBlock(MemoryBlockHeader *header, size_t size, MemoryTag tag)
+{
+    header->size = size;
+    header->tag = tag;
+    header->magic = MEMORY_BLOCK_MAGIC;
+    chargeBlock(tag, (long long)size);
+
+    return header + 1;
+}
+
+//----------------------------------------------------------------------------------
+// Allocation Hooks Definition
+//----------------------------------------------------------------------------------
+void *TrackedMalloc(size_t size)
+{
+    MemoryBlockHeader *header = (MemoryBlockHeader *)malloc(sizeof(MemoryBlockHeader) + size);
+    if (header == NULL) return NULL;
+
+    return startBlock(header, size, currentTag);
+}
+
+void *TrackedCalloc(size_t count, size_t size)
+{
+    if ((size != 0) && (count > (SIZE_MAX - sizeof(MemoryBlockHeader))/size)) return NULL;
+
+    void *ptr = TrackedMalloc(count*size);
+    if (ptr != NULL) memset(ptr, 0, count*size);
+
+    return ptr;
+}
+
+void *TrackedRealloc(void *ptr, size_t size)
+{
+    if (ptr == NULL) return TrackedMalloc(size);
+
+    MemoryBlockHeader *header = getBlockHeader(ptr);
+    MemoryTag tag = (MemoryTag)header->tag;
+    size_t oldSize = (size_t)header->size;
+
+    // Header cleared first, realloc() may free the old block
+    header->magic = 0;
+    MemoryBlockHeader *resized = (MemoryBlockHeader *)realloc(header, sizeof(MemoryBlockHeader) + size);
+
+    if (resized == NULL)
+    {
+        header->magic = MEMORY_BLOCK_MAGIC;
+        return NULL;
+    }
+
+    dischargeBlock(tag, (long long)oldSize);
+
+    return startBlock(resized, size, tag);
+}
+
+void TrackedFree(void *ptr)
+{
+    if (ptr == NULL) return;
+
+    MemoryBlockHeader *header = getBlockHeader(ptr);
+
+    dischargeBlock((MemoryTag)header->tag, (long long)header->size);
+    header->magic = 0;
+    free(header);
+}
+
+//----------------------------------------------------------------------------------
+// Memory Tracker Functions Definition
+//----------------------------------------------------------------------------------
+MemoryTag SetMemoryTag(MemoryTag tag)
+{
+    MemoryTag previous = currentTag;
+    currentTag = tag;
+
+    return previous;
+}
+
+void GetMemoryStats(MemoryTagStats *stats)
+{
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        stats[i].name = tagNames[i];
+        stats[i].liveCount = counters[i].liveCount.load(std::memory_order_relaxed);
+        stats[i].liveBytes = counters[i].liveBytes.load(std::memory_order_relaxed);
+        stats[i].peakBytes = counters[i].peakBytes.load(std::memory_order_relaxed);
+        stats[i].highWaterBytes = counters[i].highWaterBytes.load(std::memory_order_relaxed);
+        stats[i].allocations = counters[i].allocations.load(std::memory_order_relaxed);
+    }
+}
+
+void ResetMemoryHighWater(void)
+{
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++) counters[i].highWaterBytes.store(counters[i].liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void TraceMemoryReport(const char *title)
+{
+    MemoryTagStats stats[MEMORY_TAG_COUNT];
+    GetMemoryStats(stats);
+
+    TraceLog(LOG_INFO, "MEMORY: %s", title);
+
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        TraceLog(LOG_INFO, "    > %-9s live %lld blocks %.1f KB | peak %.1f KB | high water %.1f KB | %llu allocations", stats[i].name,
+            stats[i].liveCount, stats[i].liveBytes/1024.0, stats[i].peakBytes/1024.0, stats[i].highWaterBytes/1024.0, stats[i].allocations);
+    }
+}
+
+void UpdateMemoryOverlay(void)
+{
+    if (IsKeyPressed(MEMORY_OVERLAY_KEY)) isOverlayVisible = !isOverlayVisible;
+}
+
+void DrawMemoryOverlay(void)
+{
+    if (!isOverlayVisible) return;
+
+    MemoryTagStats stats[MEMORY_TAG_COUNT];
+    GetMemoryStats(stats);
+
+    int rowHeight = 12;
+    int posX = GetScreenWidth() - 470;
+    int posY = 10;
+
+    DrawRectangle(posX - 5, posY - 5, 465, (MEMORY_TAG_COUNT + 2)*rowHeight + 10, Fade(BLACK, 0.75f));
+    DrawText(TextFormat("%-10s %8s %10s %10s %10s %10s", "tag (KB)", "blocks", "live", "peak", "high wat.", "allocs"), posX, posY, 10, YELLOW);
+
+    for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        const MemoryTagStats &tag = stats[i];
+        DrawText(TextFormat("%-10s %8lld %10.1f %10.1f %10.1f %10llu", tag.name, tag.liveCount, tag.liveBytes/1024.0, tag.peakBytes/1024.0, tag.highWaterBytes/1024.0, tag.allocations),
+            posX, posY + (i + 1)*rowHeight, 10, RAYWHITE);
+    }
+
+    DrawText("F6 hide, high water since the last screen change", posX, posY + (MEMORY_TAG_COUNT + 1)*rowHeight, 10, GRAY);
+}
+
+#endif // TRACK_MEMORY
@@ -0,0 +1,77 @@
+/**********************************************************************************************
+*
+*   Memory Tracker - Heap usage per subsystem, for raylib and the game alike
+*
+*   raylib allocations reach the tracker through the RL_MALLOC hooks (see memory_hooks.h),
+*   game allocations through the global operator new (see allocation_counter.cpp). Every
+*   block carries a small header with its size and the tag of the thread that allocated it,
+*   set with MEMORY_TAG_SCOPE(tag) around loading code: a texture decoded by raylib on an
+*   asset cache worker is charged to MEMORY_TAG_TEXTURES, a vector grown by the simulation
+*   to MEMORY_TAG_GAMEPLAY. Untagged allocations go to MEMORY_TAG_OTHER.
+*
+*   Per tag: live blocks and bytes, bytes peak since start, a high-water mark reset at every
+*   screen change (so each screen reports its own) and total allocations. F6 toggles an
+*   overlay, TraceMemoryReport() logs the table, at shutdown what is still live leaked.
+*
+*   Compiled in with TRACK_MEMORY (on by default in debug builds, premake --memory for
+*   release). Without it MEMORY_TAG_SCOPE() expands to nothing and no tracker code is built,
+*   callers guard their other calls the same way.
+*
+**********************************************************************************************/
+
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include "memory_hooks.h"
+
+#if defined(TRACK_MEMORY)
+
+#define MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT_INNER(a, b)
+#define MEMORY_TAG_SCOPE(tag) MemoryTagScope MEMORY_TAG_CONCAT(memoryTagScope, __LINE__)(tag)
+
+typedef enum MemoryTag {
+    MEMORY_TAG_OTHER = 0,
+    MEMORY_TAG_TEXTURES,
+    MEMORY_TAG_AUDIO,
+    MEMORY_TAG_FONTS,
+    MEMORY_TAG_GAMEPLAY,
+    MEMORY_TAG_FILE_IO,
+    MEMORY_TAG_COUNT
+} MemoryTag;
+
+typedef struct MemoryTagStats {
+    const char *name;
+    long long liveCount;                // Blocks allocated and not freed yet
+    long long liveBytes;
+    long long peakBytes;                // Highest liveBytes since start
+    long long highWaterBytes;           // Highest liveBytes since the last ResetMemoryHighWater()
+    unsigned long long allocations;     // Every allocation so far, reallocations included
+} MemoryTagStats;
+
+//----------------------------------------------------------------------------------
+// Memory Tracker Functions Declaration
+//----------------------------------------------------------------------------------
+MemoryTag SetMemoryTag(MemoryTag tag);          // Calling thread only, returns the previous tag
+void GetMemoryStats(MemoryTagStats *stats);     // Fills MEMORY_TAG_COUNT entries
+void ResetMemoryHighWater(void);
+void TraceMemoryReport(const char *title);      // One log line per tag
+
+void UpdateMemoryOverlay(void);                 // Reads the toggle key
+void DrawMemoryOverlay(void);                   // Draws the table when visible, call last in the frame
+
+// Tags its own lifetime
+struct MemoryTagScope {
+    MemoryTag previous;
+
+    explicit MemoryTagScope(MemoryTag tag) : previous(SetMemoryTag(tag)) { }
+    ~MemoryTagScope() { SetMemoryTag(previous); }
+};
+
+#else
+
+#define MEMORY_TAG_SCOPE(tag)
+
+#endif // TRACK_MEMORY
+
+#endif // MEMORY_TRACKER_H
@@ -0,0 +1,236 @@
+/**********************************************************************************************
+*
+*   Particle System - Pooled cosmetic particles (debris, thrust trails, pickup sparkles)
+*
+**********************************************************************************************/
+
+#include "particle_system.h"
+#include <math.h>                   // Required for: cosf(), sinf()
+#include <algorithm>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define PARTICLE_KERNEL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define PARTICLE_KERNEL_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define PARTICLE_KERNEL_NEON
+#endif
+
+#define PARTICLE_DRAG 0.96f             // Velocity kept every tick
+#define PARTICLE_SEED 0x5eed5eedu
+
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    #define PARTICLE_BATCH_MAX_QUADS 16384      // 65536 vertices, the 16 bit index limit
+#else
+    #define PARTICLE_BATCH_MAX_QUADS 1048576
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Uniform value in [0, 1)
+static float getRandomUnit(Prng *rng)
+{
+    return (GetPrngNext(rng) >> 8)*(1.0f/16777216.0f);
+}
+
+static float getRandomRange(Prng *rng, float min, float max)
+{
+    return min + (max - min)*getRandomUnit(rng);
+}
+
+// Scalar version, also used for the tail of the SIMD loops
+static void updateParticlesScalar(float *positionX, float *positionY, float *velocityX, float *velocityY, float *life, int first, int count)
+{
+    for (int i = first; i < count; i++)
+    {
+        positionX[i] += velocityX[i];
+        positionY[i] += velocityY[i];
+        velocityX[i] *= PARTICLE_DRAG;
+        velocityY[i] *= PARTICLE_DRAG;
+        life[i] -= 1.0f;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Particle System Functions Definition
+//----------------------------------------------------------------------------------
+void InitParticleSystem(ParticleSystem *system, int capacity)
+{
+    system->count = 0;
+    system->capacity = capacity;
+    system->positionX.resize(capacity);
+    system->positionY.resize(capacity);
+    system->velocityX.resize(capacity);
+    system->velocityY.resize(capacity);
+    system->life.resize(capacity);
+    system->fade.resize(capacity);
+    system->size.resize(capacity);
+    system->color.resize(capacity);
+    SeedPrng(&system->rng, PARTICLE_SEED);
+
+    system->batch = rlLoadRenderBatch(1, std::min(capacity, PARTICLE_BATCH_MAX_QUADS));
+}
+
+void UnloadParticleSystem(ParticleSystem *system)
+{
+    rlUnloadRenderBatch(system->batch);
+    system->batch = { 0 };
+    system->count = 0;
+}
+
+void ClearParticles(ParticleSystem *system)
+{
+    system->count = 0;
+}
+
+void EmitParticles(ParticleSystem *system, const ParticleEmitter *emitter, Vector2 position, float directionDegrees)
+{
+    int count = std::min(emitter->count, system->capacity - system->count);
+
+    for (int k = 0; k < count; k++)
+    {
+        int i = system->count++;
+        float radians = (directionDegrees + emitter->spreadDegrees*(getRandomUnit(&system->rng) - 0.5f))*DEG2RAD;
+        float speed = getRandomRange(&system->rng, emitter->minSpeed, emitter->maxSpeed);
+        float life = getRandomRange(&system->rng, emitter->minLife, emitter->maxLife);
+
+        system->positionX[i] = position.x;
+        system->positionY[i] = position.y;
+        system->velocityX[i] = speed*cosf(radians);
+        system->velocityY[i] = speed*sinf(radians);
+        system->life[i] = life;
+        system->fade[i] = 1.0f/life;
+        system->size[i] = getRandomRange(&system->rng, emitter->minSize, emitter->maxSize);
+        system->color[i] = emitter->color;
+    }
+}
+
+void UpdateParticles(ParticleSystem *system)
+{
+    float *positionX = system->positionX.data();
+    float *positionY = system->positionY.data();
+    float *velocityX = system->velocityX.data();
+    float *velocityY = system->velocityY.data();
+    float *life = system->life.data();
+    int count = system->count;
+    int i = 0;
+
+#if defined(PARTICLE_KERNEL_AVX2)
+    const __m256 drag = _mm256_set1_ps(PARTICLE_DRAG);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 vx = _mm256_loadu_ps(velocityX + i);
+        __m256 vy = _mm256_loadu_ps(velocityY + i);
+
+        _mm256_storeu_ps(positionX + i, _mm256_add_ps(_mm256_loadu_ps(positionX + i), vx));
+        _mm256_storeu_ps(positionY + i, _mm256_add_ps(_mm256_loadu_ps(positionY + i), vy));
+        _mm256_storeu_ps(velocityX + i, _mm256_mul_ps(vx, drag));
+        _mm256_storeu_ps(velocityY + i, _mm256_mul_ps(vy, drag));
+        _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), one));
+    }
+#elif defined(PARTICLE_KERNEL_SSE2)
+    const __m128 drag = _mm_set1_ps(PARTICLE_DRAG);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 vx = _mm_loadu_ps(velocityX + i);
+        __m128 vy = _mm_loadu_ps(velocityY + i);
+
+        _mm_storeu_ps(positionX + i, _mm_add_ps(_mm_loadu_ps(positionX + i), vx));
+        _mm_storeu_ps(positionY + i, _mm_add_ps(_mm_loadu_ps(positionY + i), vy));
+        _mm_storeu_ps(velocityX + i, _mm_mul_ps(vx, drag));
+        _mm_storeu_ps(velocityY + i, _mm_mul_ps(vy, drag));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), one));
+    }
+#elif defined(PARTICLE_KERNEL_NEON)
+    const float32x4_t drag = vdupq_n_f32(PARTICLE_DRAG);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t vx = vld1q_f32(velocityX + i);
+        float32x4_t vy = vld1q_f32(velocityY + i);
+
+        vst1q_f32(positionX + i, vaddq_f32(vld1q_f32(positionX + i), vx));
+        vst1q_f32(positionY + i, vaddq_f32(vld1q_f32(positionY + i), vy));
+        vst1q_f32(velocityX + i, vmulq_f32(vx, drag));
+        vst1q_f32(velocityY + i, vmulq_f32(vy, drag));
+        vst1q_f32(life + i, vsubq_f32(vld1q_f32(life + i), one));
+    }
+#endif
+
+    updateParticlesScalar(positionX, positionY, velocityX, velocityY, life, i, count);
+
+    // Swap-remove the dead ones, draw order does not matter with additive blending
+    for (i = 0; i < count;)
+    {
+        if (life[i] > 0.0f) { i++; continue; }
+
+        count--;
+        positionX[i] = positionX[count];
+        positionY[i] = positionY[count];
+        velocityX[i] = velocityX[count];
+        velocityY[i] = velocityY[count];
+        life[i] = life[count];
+        system->fade[i] = system->fade[count];
+        system->size[i] = system->size[count];
+        system->color[i] = system->color[count];
+    }
+
+    system->count = count;
+}
+
+// NOTE: Switching batches draws whatever was queued before, so particles keep their place in the draw order
+void DrawParticles(ParticleSystem *system, float interpolation)
+{
+    if (system->count == 0) return;
+
+    // Drag is small per tick, one velocity step back is close enough to the previous position
+    float tickRemainder = 1.0f - interpolation;
+
+    rlSetRenderBatchActive(&system->batch);
+    BeginBlendMode(BLEND_ADDITIVE);
+    rlBegin(RL_QUADS);
+
+    for (int i = 0; i < system->count; i++)
+    {
+        float x = system->positionX[i] - system->velocityX[i]*tickRemainder;
+        float y = system->positionY[i] - system->velocityY[i]*tickRemainder;
+        float half = system->size[i]/2;
+        float alpha = std::min(system->life[i]*system->fade[i], 1.0f);
+        Color color = system->color[i];
+
+        rlColor4ub(color.r, color.g, color.b, (unsigned char)(color.a*alpha));
+
+        // Same winding as DrawRectanglePro()
+        rlVertex2f(x - half, y - half);
+        rlVertex2f(x - half, y + half);
+        rlVertex2f(x + half, y + half);
+        rlVertex2f(x + half, y - half);
+    }
+
+    rlEnd();
+    rlSetRenderBatchActive(NULL);       // Draws the particle batch
+    EndBlendMode();
+}
+
+const char *GetParticleKernelName(void)
+{
+#if defined(PARTICLE_KERNEL_AVX2)
+    return "AVX2";
+#elif defined(PARTICLE_KERNEL_SSE2)
+    return "SSE2";
+#elif defined(PARTICLE_KERNEL_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
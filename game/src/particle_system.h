@@ -0,0 +1,67 @@
+/**********************************************************************************************
+*
+*   Particle System - Pooled cosmetic particles (debris, thrust trails, pickup sparkles)
+*
+*   Particles live in flat arrays sized once at init, emitting past the capacity drops the
+*   extra particles instead of allocating. UpdateParticles() advances one tick: a SIMD pass
+*   (AVX2, SSE2 or NEON, picked at compile time, scalar fallback) moves, drags and ages
+*   every particle, then dead ones are swap-removed. DrawParticles() writes every live
+*   particle as one quad into a render batch owned by the system, so the whole pool goes
+*   to the GPU in a single draw call (several on GLES2, limited to 16 bit indices).
+*
+*   Particles never touch the simulation: they use their own generator, so effects can not
+*   change a game or desync a replay.
+*
+**********************************************************************************************/
+
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "raylib.h"
+#include "rlgl.h"                   // Required for: rlRenderBatch
+#include "prng.h"
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ParticleSystem {
+    int count;
+    int capacity;
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;       // Pixels per tick
+    std::vector<float> velocityY;
+    std::vector<float> life;            // Ticks left, removed at 0
+    std::vector<float> fade;            // 1/initial life, alpha is life*fade
+    std::vector<float> size;            // Quad side, pixels
+    std::vector<Color> color;
+    Prng rng;
+    rlRenderBatch batch;
+} ParticleSystem;
+
+// Burst or trail description, speeds in pixels per tick, lives in ticks
+typedef struct ParticleEmitter {
+    int count;                          // Particles per EmitParticles() call
+    float spreadDegrees;                // Around the emit direction, 360 for a full burst
+    float minSpeed;
+    float maxSpeed;
+    float minLife;
+    float maxLife;
+    float minSize;
+    float maxSize;
+    Color color;
+} ParticleEmitter;
+
+//----------------------------------------------------------------------------------
+// Particle System Functions Declaration
+//----------------------------------------------------------------------------------
+void InitParticleSystem(ParticleSystem *system, int capacity);     // Needs the window, loads the render batch
+void UnloadParticleSystem(ParticleSystem *system);
+void ClearParticles(ParticleSystem *system);
+void EmitParticles(ParticleSystem *system, const ParticleEmitter *emitter, Vector2 position, float directionDegrees);
+void UpdateParticles(ParticleSystem *system);                     // Advance one tick
+void DrawParticles(ParticleSystem *system, float interpolation);  // Additive blending, one batch
+const char *GetParticleKernelName(void);                          // Variant compiled in, for logging
+
+#endif // PARTICLE_SYSTEM_H
@@ -0,0 +1,60 @@
+/**********************************************************************************************
+*
+*   Profiler Overlay - On-screen view and export keys for the phase profiler
+*
+**********************************************************************************************/
+
+#include "profiler_overlay.h"
+
+#if defined(ENABLE_PROFILER)
+
+#include "raylib.h"
+
+#define PROFILER_OVERLAY_FRAMES 60      // Rolling window the percentiles are computed over
+#define PROFILER_CSV_FILE "profile.csv"
+#define PROFILER_TRACE_FILE "profile.json"
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static bool isOverlayVisible = false;
+static ProfileStats overlayStats[PROFILER_MAX_PHASES];
+
+//----------------------------------------------------------------------------------
+// Profiler Overlay Functions Definition
+//----------------------------------------------------------------------------------
+void UpdateProfilerOverlay(void)
+{
+    if (IsKeyPressed(KEY_F3)) isOverlayVisible = !isOverlayVisible;
+
+    if (IsKeyPressed(KEY_F4))
+    {
+        bool exported = ExportProfileCsv(PROFILER_CSV_FILE) && ExportProfileChromeTrace(PROFILER_TRACE_FILE);
+
+        if (exported) TraceLog(LOG_INFO, "PROFILER: Exported %s and %s", PROFILER_CSV_FILE, PROFILER_TRACE_FILE);
+        else TraceLog(LOG_WARNING, "PROFILER: Export failed");
+    }
+}
+
+void DrawProfilerOverlay(void)
+{
+    if (!isOverlayVisible) return;
+
+    int count = GetProfileStats(overlayStats, PROFILER_MAX_PHASES, PROFILER_OVERLAY_FRAMES);
+    int rowHeight = 12;
+    int posX = 10;
+    int posY = GetScreenHeight() - (count + 2)*rowHeight - 10;
+
+    DrawRectangle(posX - 5, posY - 5, 480, (count + 2)*rowHeight + 10, Fade(BLACK, 0.75f));
+    DrawText(TextFormat("%-26s %8s %8s %8s %8s", "phase (us)", "p50", "p95", "p99", "max"), posX, posY, 10, YELLOW);
+
+    for (int i = 0; i < count; i++)
+    {
+        const ProfileStats &stats = overlayStats[i];
+        DrawText(TextFormat("%-26s %8.1f %8.1f %8.1f %8.1f", stats.name, stats.p50, stats.p95, stats.p99, stats.max), posX, posY + (i + 1)*rowHeight, 10, RAYWHITE);
+    }
+
+    DrawText("F3 hide  F4 export csv/json", posX, posY + (count + 1)*rowHeight, 10, GRAY);
+}
+
+#endif // ENABLE_PROFILER
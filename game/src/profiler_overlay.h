@@ -0,0 +1,26 @@
+/**********************************************************************************************
+*
+*   Profiler Overlay - On-screen view and export keys for the phase profiler
+*
+*   F3 toggles a table with rolling p50/p95/p99 per phase over the last second of frames,
+*   F4 writes every event still in the ring to profile.csv and profile.json (Chrome trace).
+*   Only built with ENABLE_PROFILER, callers guard their calls the same way.
+*
+**********************************************************************************************/
+
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+#include "profiler.h"
+
+#if defined(ENABLE_PROFILER)
+
+//----------------------------------------------------------------------------------
+// Profiler Overlay Functions Declaration
+//----------------------------------------------------------------------------------
+void UpdateProfilerOverlay(void);       // Reads the toggle and export keys
+void DrawProfilerOverlay(void);         // Draws the table when visible, call last in the frame
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_OVERLAY_H
@@ -14,6 +14,27 @@
 
 #include "raylib.h"
 #include "screens.h"    // NOTE: Declares global (extern) variables and screens functions
+#include "asset_cache.h"
+#include "profiler_overlay.h"
+#include "memory_tracker.h"
+#include "tick_input.h"
+#include "stress_benchmark.h"
+#include "simulation.h"     // Required for: SIM_TICKS_PER_SECOND
+#include <stdlib.h>     // Required for: atoi()
+#include <string.h>     // Required for: strcmp()
+#include <thread>       // Required for: std::this_thread::sleep_for()
+#include <chrono>
+
+#define ASSET_CACHE_BUDGET 64*1024*1024     // Resident bytes before released assets start being evicted
+#define ASSET_UPLOAD_BUDGET 0.002           // Seconds per frame spent uploading preloaded assets
+
+#define FIXED_TIMESTEP (1.0f/SIM_TICKS_PER_SECOND)
+#define MAX_FRAME_TIME 0.25f                // Longer frames (window drag, breakpoints) are not caught up
+
+#define REDUCED_REFRESH_FPS 20              // Menus with slow animations only
+#define IDLE_REFRESH_FPS 10                 // Static menus while their music plays, UpdateMusicStream() must keep up
+#define INPUT_FULL_REFRESH_TIME 0.5         // Seconds at full rate after any input
+#define MUSIC_STREAM_BUFFER_FRAMES 8192     // Two halves of ~0.18 s, outlast an idle frame
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
@@ -37,9 +58,70 @@ float volumeLevel;
 int highestPointScore;
 int highestTimeScore;
 
+const char *replayFileName = NULL;     // Set with --replay, gameplay then plays the file back
+int stressAsteroidCount = 0;
+float renderInterpolation = 0.0f;
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Screen entry points, preload (may be NULL) queues the screen assets for background decoding
+typedef struct ScreenFunctions {
+    void (*preload)(void);
+    void (*init)(void);
+    void (*update)(void);
+    void (*draw)(void);
+    void (*unload)(void);
+    int (*finish)(void);
+    ScreenRefresh (*refresh)(void);     // NULL always renders at full rate
+    bool (*suspend)(void);              // NULL or false unloads, true keeps the screen resident
+    void (*resume)(void);               // Replaces init when coming back to a suspended screen
+} ScreenFunctions;
+
+// Where a screen goes when it finishes with a given code
+typedef struct ScreenRoute {
+    GameScreen from;
+    int finishCode;
+    GameScreen to;
+    bool isFaded;                   // False changes at once, for screens whose assets are still resident
+    bool isSuspending;              // From screen is suspended instead of unloaded, until a route leads back to it
+} ScreenRoute;
+
 //----------------------------------------------------------------------------------
 // Local Variables Definition (local to this module)
 //----------------------------------------------------------------------------------
+
+// Indexed by GameScreen
+static const ScreenFunctions screenTable[] = {
+    { NULL, InitLogoScreen, UpdateLogoScreen, DrawLogoScreen, UnloadLogoScreen, FinishLogoScreen, NULL, NULL, NULL },
+    { PreloadTitleScreen, InitTitleScreen, UpdateTitleScreen, DrawTitleScreen, UnloadTitleScreen, FinishTitleScreen, GetTitleScreenRefresh, NULL, NULL },
+    { NULL, InitOptionsScreen, UpdateOptionsScreen, DrawOptionsScreen, UnloadOptionsScreen, FinishOptionsScreen, GetOptionsScreenRefresh, NULL, NULL },
+    { PreloadGameplayScreen, InitGameplayScreen, UpdateGameplayScreen, DrawGameplayScreen, UnloadGameplayScreen, FinishGameplayScreen, NULL, SuspendGameplayScreen, ResumeGameplayScreen },
+    { NULL, InitEndingScreen, UpdateEndingScreen, DrawEndingScreen, UnloadEndingScreen, FinishEndingScreen, GetEndingScreenRefresh, NULL, NULL },
+    { NULL, InitCreditsScreen, UpdateCreditsScreen, DrawCreditsScreen, UnloadCreditsScreen, FinishCreditsScreen, GetCreditsScreenRefresh, NULL, NULL },
+};
+
+static_assert(sizeof(screenTable)/sizeof(screenTable[0]) == CREDITS + 1, "One screenTable entry per GameScreen");
+
+#if defined(TRACK_MEMORY)
+// Indexed by GameScreen, memory reports name the screen that just unloaded
+static const char *screenNames[] = { "LOGO", "TITLE", "OPTIONS", "GAMEPLAY", "ENDING", "CREDITS" };
+#endif
+
+// NOTE: Title finish codes are the GameScreen picked in its menu
+static const ScreenRoute screenRoutes[] = {
+    { LOGO, 1, TITLE, true, false },
+    { TITLE, OPTIONS, OPTIONS, true, false },
+    { TITLE, GAMEPLAY, GAMEPLAY, true, false },
+    { TITLE, CREDITS, CREDITS, true, false },
+    { OPTIONS, 1, TITLE, true, false },
+    { GAMEPLAY, 1, ENDING, true, true },    // Gameplay waits behind the ending screen for a Play again
+    { CREDITS, 1, TITLE, true, false },
+    { ENDING, 1, TITLE, true, false },      // Leaving to the title unloads the suspended gameplay too
+    { ENDING, 3, GAMEPLAY, false, false },  // Play again resumes the resident gameplay, no fade needed
+};
+
 static const int screenWidth = 1280;
 static const int screenHeight = 720;
 
@@ -47,56 +129,116 @@ static const int screenHeight = 720;
 static float transAlpha = 0.0f;
 static bool onTransition = false;
 static bool transFadeOut = false;
-static int transFromScreen = -1;
+static GameScreen transFromScreen = UNKNOWN;
 static GameScreen transToScreen = UNKNOWN;
+static bool transIsSuspending = false;
+
+static GameScreen suspendedScreen = UNKNOWN;    // Kept resident by a suspending route, see leaveScreen()
+
+// Fixed-step update state
+static int renderFps = 60;              // Set with --fps, 0 renders as fast as possible
+static float tickAccumulator = 0.0f;    // Frame time not yet consumed by ticks
+
+// Adaptive render rate state, see UpdateRefreshRate()
+static int refreshFps = 60;             // Rate of the current frame, renderFps when at full rate
+static bool isWaitingEvents = false;    // Frames are only drawn on input events
+static double lastInputTime = 0.0;
+static double frameStartTime = 0.0;
+
+static const char *benchmarkFileName = NULL;    // Set with --benchmark, runs the stress sweep and exits
+static const char *particleBenchmarkFileName = NULL;    // Set with --benchmark-particles, runs the particle sweep and exits
 
 //----------------------------------------------------------------------------------
 // Local Functions Declaration
 //----------------------------------------------------------------------------------
-static void ChangeToScreen(int screen);     // Change to screen, no transition effect
+static void ChangeToScreen(GameScreen screen, bool isSuspending);      // Change to screen, no transition effect
 
-static void TransitionToScreen(int screen); // Request transition to next screen
+static void TransitionToScreen(GameScreen screen, bool isSuspending);  // Request transition to next screen
 static void UpdateTransition(void);         // Update transition effect
 static void DrawTransition(void);           // Draw transition effect (full-screen rectangle)
+static void leaveScreen(GameScreen screen, GameScreen next, bool isSuspending);     // Unload or suspend the screen being left
+static void enterScreen(GameScreen screen);                                         // Init or resume the screen being entered
 
+static void UpdateTick(void);               // Update one fixed tick
+static void UpdateRefreshRate(void);        // Pick the render rate of the frame being drawn
+static void WaitRefreshRate(void);          // Sleep out a reduced rate frame
 static void UpdateDrawFrame(void);          // Update and draw one frame
 
+#if defined(TRACK_MEMORY)
+static void TraceScreenMemory(GameScreen screen);   // Report of the screen just unloaded, high-water marks start over
+#endif
+
 
 
 //----------------------------------------------------------------------------------
 // Main entry point
 //----------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char *argv[])
 {
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc)) replayFileName = argv[++i];
+        else if ((strcmp(argv[i], "--fps") == 0) && (i + 1 < argc)) renderFps = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--stress") == 0) && (i + 1 < argc)) stressAsteroidCount = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--benchmark") == 0) && (i + 1 < argc)) benchmarkFileName = argv[++i];
+        else if ((strcmp(argv[i], "--benchmark-particles") == 0) && (i + 1 < argc)) particleBenchmarkFileName = argv[++i];
+    }
+
     // Initialization
     //---------------------------------------------------------
     InitWindow(screenWidth, screenHeight, "ASTEROIDS - PAC 1");
 
-    InitAudioDevice();      // Initialize audio device
+    {
+        MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+        InitAudioDevice();      // Initialize audio device
+    }
+
+    InitAssetCache(ASSET_CACHE_BUDGET);     // Screen assets stay resident between screen changes
+    InitStorage();                          // Leaderboard is read once, screens only touch memory
 
 
     volumeLevel = 1.0f;
 
+    // Idle menus update the music stream at IDLE_REFRESH_FPS, the default buffer only holds 1/30 s
+    SetAudioStreamBufferSizeDefault(MUSIC_STREAM_BUFFER_FRAMES);
+
     // Load global data (assets that must be available in all screens, i.e. font)
-    font = LoadFont("resources/textures/setback.png");
-    music = LoadMusicStream("resources/Music/MainMenuMusic.ogg");
-    fxCoin = LoadSound("resources/coin.wav");
-    backgroundImage = LoadTexture("resources/textures/Landscape.png");
+    {
+        MEMORY_TAG_SCOPE(MEMORY_TAG_FONTS);
+        font = LoadFont("resources/textures/setback.png");
+    }
+    {
+        MEMORY_TAG_SCOPE(MEMORY_TAG_AUDIO);
+        music = LoadMusicStream("resources/Music/MainMenuMusic.ogg");
+        fxCoin = LoadSound("resources/coin.wav");
+    }
+    {
+        MEMORY_TAG_SCOPE(MEMORY_TAG_TEXTURES);
+        backgroundImage = LoadTexture("resources/textures/Landscape.png");
+    }
     SetMusicVolume(music, volumeLevel);
     PlayMusicStream(music);
 
-    // Setup and init first screen
-    currentScreen = LOGO;
-    InitLogoScreen();
+    // Setup and init first screen, replays and stress runs go straight to gameplay
+    if ((benchmarkFileName != NULL) || (particleBenchmarkFileName != NULL)) currentScreen = UNKNOWN;     // Sweeps drive their frames themselves
+    else
+    {
+        currentScreen = ((replayFileName != NULL) || (stressAsteroidCount > 0))? GAMEPLAY : LOGO;
+        screenTable[currentScreen].init();
+    }
 
 #if defined(PLATFORM_WEB)
-    emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);    // Browser refresh rate, ticks stay fixed
 #else
-    SetTargetFPS(60);       // Set our game to run at 60 frames-per-second
+    SetTargetFPS(renderFps);    // Render rate only, gameplay ticks at SIM_TICKS_PER_SECOND
+    refreshFps = renderFps;
+
+    if (benchmarkFileName != NULL) RunStressBenchmark(benchmarkFileName);
+    if (particleBenchmarkFileName != NULL) RunParticleBenchmark(particleBenchmarkFileName);
     //--------------------------------------------------------------------------------------
 
     // Main game loop
-    while (!WindowShouldClose())    // Detect window close button or ESC key
+    while ((currentScreen != UNKNOWN) && !WindowShouldClose())    // Detect window close button or ESC key
     {
         UpdateDrawFrame();
     }
@@ -104,17 +246,9 @@ int main(void)
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
-    // Unload current screen data before closing
-    switch (currentScreen)
-    {
-        case LOGO: UnloadLogoScreen(); break;
-        case TITLE: UnloadTitleScreen(); break;
-        case GAMEPLAY: UnloadGameplayScreen(); break;
-        case ENDING: UnloadEndingScreen(); break;
-        case CREDITS: UnloadCreditsScreen(); break;
-        case OPTIONS: UnloadOptionsScreen(); break;
-        default: break;
-    }
+    // Unload current screen data before closing, and the screen suspended behind it
+    if (currentScreen != UNKNOWN) screenTable[currentScreen].unload();
+    if (suspendedScreen != UNKNOWN) screenTable[suspendedScreen].unload();
 
     // Unload global data loaded
     UnloadFont(font);
@@ -122,9 +256,17 @@ int main(void)
     UnloadSound(fxCoin);
     UnloadTexture(backgroundImage);
 
+    UnloadAssetCache();
+    CloseStorage();         // Writes runs still pending
+
     CloseAudioDevice();     // Close audio context
 
     CloseWindow();          // Close window and OpenGL context
+
+#if defined(TRACK_MEMORY)
+    // Everything is unloaded, what is still live leaked (or is held by static containers)
+    TraceMemoryReport("Still allocated at shutdown");
+#endif
     //--------------------------------------------------------------------------------------
 
     return 0;
@@ -134,46 +276,63 @@ int main(void)
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
 // Change to next screen, no transition
-static void ChangeToScreen(GameScreen screen)
+static void ChangeToScreen(GameScreen screen, bool isSuspending)
 {
-    // Unload current screen
-    switch (currentScreen)
-    {
-        case LOGO: UnloadLogoScreen(); break;
-        case TITLE: UnloadTitleScreen(); break;
-        case GAMEPLAY: UnloadGameplayScreen(); break;
-        case ENDING: UnloadEndingScreen(); break;
-        case CREDITS: UnloadCreditsScreen(); break;
-        case OPTIONS: UnloadOptionsScreen(); break;
-        default: break;
-    }
-
-    // Init next screen
-    switch (screen)
-    {
-        case LOGO: InitLogoScreen(); break;
-        case TITLE: InitTitleScreen(); break;
-        case GAMEPLAY: InitGameplayScreen(); break;
-        case ENDING: InitEndingScreen(); break;
-        case CREDITS: InitCreditsScreen(); break;
-        case OPTIONS: InitOptionsScreen(); break;
-        default: break;
-    }
-
-    currentScreen = screen;
+    if (currentScreen != UNKNOWN) leaveScreen(currentScreen, screen, isSuspending);
+    enterScreen(screen);
 }
 
-// Request transition to next screen
-static void TransitionToScreen(GameScreen screen)
+// Request transition to next screen, its assets start decoding while the screen fades in
+static void TransitionToScreen(GameScreen screen, bool isSuspending)
 {
     onTransition = true;
     transFadeOut = false;
     transFromScreen = currentScreen;
     transToScreen = screen;
+    transIsSuspending = isSuspending;
     transAlpha = 0.0f;
+
+    // NOTE: A suspended screen still holds its assets
+    if ((screenTable[screen].preload != NULL) && (screen != suspendedScreen)) screenTable[screen].preload();
 }
 
+// Unload the screen being left, or only suspend it when the route comes back to it later
+// A suspended screen stays resident until the next screen left leads anywhere else
+static void leaveScreen(GameScreen screen, GameScreen next, bool isSuspending)
+{
+    if (isSuspending && (screenTable[screen].suspend != NULL) && screenTable[screen].suspend())
+    {
+        suspendedScreen = screen;
+        return;
+    }
+
+    screenTable[screen].unload();
+#if defined(TRACK_MEMORY)
+    TraceScreenMemory(screen);
+#endif
+
+    if ((suspendedScreen != UNKNOWN) && (suspendedScreen != next))
+    {
+        screenTable[suspendedScreen].unload();
+#if defined(TRACK_MEMORY)
+        TraceScreenMemory(suspendedScreen);
+#endif
+        suspendedScreen = UNKNOWN;
+    }
+}
 
+// Init the screen being entered, a suspended one is resumed instead
+static void enterScreen(GameScreen screen)
+{
+    if (screen == suspendedScreen)
+    {
+        screenTable[screen].resume();
+        suspendedScreen = UNKNOWN;
+    }
+    else screenTable[screen].init();
+
+    currentScreen = screen;
+}
 
 // Update transition effect (fade-in, fade-out)
 static void UpdateTransition(void)
@@ -188,31 +347,12 @@ static void UpdateTransition(void)
         {
             transAlpha = 1.0f;
 
-            // Unload current screen
-            switch (transFromScreen)
-            {
-                case LOGO: UnloadLogoScreen(); break;
-                case TITLE: UnloadTitleScreen(); break;
-                case GAMEPLAY: UnloadGameplayScreen(); break;
-                case ENDING: UnloadEndingScreen(); break;
-                case CREDITS: UnloadCreditsScreen(); break;
-                case OPTIONS: UnloadOptionsScreen(); break;
-                default: break;
-            }
-
-            // Load next screen
-            switch (transToScreen)
-            {
-                case LOGO: InitLogoScreen(); break;
-                case TITLE: InitTitleScreen(); break;
-                case GAMEPLAY: InitGameplayScreen(); break;
-                case ENDING: InitEndingScreen(); break;
-                case CREDITS: InitCreditsScreen(); break;
-                case OPTIONS: InitOptionsScreen(); break;
-                default: break;
-            }
-
-            currentScreen = transToScreen;
+            // Stay black until the preload is uploaded, the next screen init then only
+            // acquires resident assets instead of decoding them in one long frame
+            if (IsAssetCacheLoading()) return;
+
+            leaveScreen(transFromScreen, transToScreen, transIsSuspending);
+            enterScreen(transToScreen);
 
             // Activate fade out effect to next loaded screen
             transFadeOut = true;
@@ -227,8 +367,9 @@ static void UpdateTransition(void)
             transAlpha = 0.0f;
             transFadeOut = false;
             onTransition = false;
-            transFromScreen = -1;
+            transFromScreen = UNKNOWN;
             transToScreen = UNKNOWN;
+            transIsSuspending = false;
         }
     }
 }
@@ -239,68 +380,76 @@ static void DrawTransition(void)
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, transAlpha));
 }
 
-// Update and draw game frame
-static void UpdateDrawFrame(void)
+// Update one fixed simulation tick of the current screen or transition
+static void UpdateTick(void)
 {
-    // Update
-    //----------------------------------------------------------------------------------
-    UpdateMusicStream(music);       // NOTE: Music keeps playing between screens
-
-    if (!onTransition)
+    if (onTransition)
     {
-        switch(currentScreen)
-        {
-            case LOGO:
-            {
-                UpdateLogoScreen();
-
-                if (FinishLogoScreen()) TransitionToScreen(TITLE);
+        UpdateTransition();     // Update transition (fade-in, fade-out)
+        return;
+    }
 
-            } break;
-            case TITLE:
-            {
-                UpdateTitleScreen();
+    if (currentScreen == UNKNOWN) return;
 
-                if (FinishTitleScreen() == 2) TransitionToScreen(OPTIONS);
-                else if (FinishTitleScreen() == 3) TransitionToScreen(GAMEPLAY);
-                else if (FinishTitleScreen() == 5) TransitionToScreen(CREDITS);
+    screenTable[currentScreen].update();
 
+    int finishCode = screenTable[currentScreen].finish();
+    if (finishCode == 0) return;
 
-            } break;
-            case OPTIONS:
-            {
-                UpdateOptionsScreen();
+    for (const ScreenRoute &route : screenRoutes)
+    {
+        if ((route.from != currentScreen) || (route.finishCode != finishCode)) continue;
 
-                if (FinishOptionsScreen()) TransitionToScreen(TITLE);
+        if (route.isFaded) TransitionToScreen(route.to, route.isSuspending);
+        else ChangeToScreen(route.to, route.isSuspending);
+        break;
+    }
+}
 
-            } break;
-            case GAMEPLAY:
-            {
-                UpdateGameplayScreen();
+// Update and draw game frame
+static void UpdateDrawFrame(void)
+{
+    // Update
+    //----------------------------------------------------------------------------------
+    PROFILE_FRAME_MARK();
+    PROFILE_SCOPE("UpdateDrawFrame");
 
-                if (FinishGameplayScreen() == 1) TransitionToScreen(ENDING);
-                //else if (FinishGameplayScreen() == 2) TransitionToScreen(TITLE);
+    frameStartTime = GetTime();
 
-            } break;
-            case CREDITS:
-            {
-                UpdateCreditsScreen();
+#if defined(ENABLE_PROFILER)
+    UpdateProfilerOverlay();
+#endif
+#if defined(TRACK_MEMORY)
+    UpdateMemoryOverlay();
+#endif
 
-                if (FinishCreditsScreen()) TransitionToScreen(TITLE);
+    {
+        PROFILE_SCOPE("UpdateMusicStream");
+        UpdateMusicStream(music);       // NOTE: Music keeps playing between screens
+    }
+    UpdateAssetCache(ASSET_UPLOAD_BUDGET);  // NOTE: Preloads finish uploading during logo and transitions
 
-            } break;
-            case ENDING:
-            {
-                UpdateEndingScreen();
+    // Fixed-step updates: screens always advance at SIM_TICKS_PER_SECOND whatever the render rate
+    float frameTime = GetFrameTime();
+    if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+    tickAccumulator += frameTime;
 
-                if (FinishEndingScreen() == 1) TransitionToScreen(TITLE);
-                if (FinishEndingScreen() == 3) TransitionToScreen(GAMEPLAY);
+    PollTickInput();
+    if (HasTickInput()) lastInputTime = GetTime();
 
-            } break;
-            default: break;
-        }
+    while (tickAccumulator >= FIXED_TIMESTEP)
+    {
+        UpdateTick();
+        ConsumeTickInput();
+        tickAccumulator -= FIXED_TIMESTEP;
     }
-    else UpdateTransition();    // Update transition (fade-in, fade-out)
+
+    // Fraction of a tick elapsed since the last update, draws blend the last two ticks with it
+    renderInterpolation = tickAccumulator/FIXED_TIMESTEP;
+
+#if !defined(PLATFORM_WEB)
+    UpdateRefreshRate();        // NOTE: Browsers pace frames themselves
+#endif
     //----------------------------------------------------------------------------------
 
     // Draw
@@ -309,23 +458,83 @@ static void UpdateDrawFrame(void)
 
         ClearBackground(RAYWHITE);
 
-        switch(currentScreen)
-        {
-            case LOGO: DrawLogoScreen(); break;
-            case TITLE: DrawTitleScreen(); break;
-            case OPTIONS: DrawOptionsScreen(); break;
-            case GAMEPLAY: DrawGameplayScreen(); break;
-            case CREDITS: DrawCreditsScreen(); break;
-            case ENDING: DrawEndingScreen(); break;
-
-            default: break;
-        }
+        if (currentScreen != UNKNOWN) screenTable[currentScreen].draw();
 
         // Draw full screen rectangle in front of everything
         if (onTransition) DrawTransition();
 
         //DrawFPS(10, 10);
 
-    EndDrawing();
+#if defined(ENABLE_PROFILER)
+        DrawProfilerOverlay();
+#endif
+#if defined(TRACK_MEMORY)
+        DrawMemoryOverlay();
+#endif
+
+    {
+        // Buffer swap plus the wait for the target frame rate
+        PROFILE_SCOPE("EndDrawing");
+#if !defined(PLATFORM_WEB)
+        WaitRefreshRate();
+#endif
+        EndDrawing();
+    }
     //----------------------------------------------------------------------------------
 }
+
+// Pick the render rate of the frame being drawn from the screen policy
+// NOTE: Fades, asset uploads and the moments after any input always run at full rate
+static void UpdateRefreshRate(void)
+{
+    ScreenRefresh refresh = REFRESH_FULL;
+    if ((currentScreen != UNKNOWN) && (screenTable[currentScreen].refresh != NULL)) refresh = screenTable[currentScreen].refresh();
+
+    if (onTransition || IsAssetCacheLoading() || ((GetTime() - lastInputTime) < INPUT_FULL_REFRESH_TIME)) refresh = REFRESH_FULL;
+
+    int fps = renderFps;
+    bool isWaiting = false;
+
+    if (refresh == REFRESH_REDUCED) fps = REDUCED_REFRESH_FPS;
+    else if (refresh == REFRESH_ON_DEMAND)
+    {
+        // Waiting for events stops the music stream updates, audible music keeps a low rate instead
+        fps = IDLE_REFRESH_FPS;
+        isWaiting = !IsMusicStreamPlaying(music) || (volumeLevel <= 0.0f);
+    }
+
+    if ((renderFps > 0) && (renderFps < fps)) fps = renderFps;
+
+    if (fps != refreshFps)
+    {
+        // Reduced rates are paced by WaitRefreshRate(), raylib's wait ends in a busy loop
+        SetTargetFPS((fps == renderFps)? renderFps : 0);
+        refreshFps = fps;
+    }
+
+    if (isWaiting != isWaitingEvents)
+    {
+        // EndDrawing() then blocks until the next input event, window events included
+        if (isWaiting) EnableEventWaiting();
+        else DisableEventWaiting();
+        isWaitingEvents = isWaiting;
+    }
+}
+
+// Sleep out a reduced rate frame before the buffer swap, input is polled right after it
+static void WaitRefreshRate(void)
+{
+    if ((refreshFps == renderFps) || (refreshFps <= 0)) return;
+
+    double remaining = frameStartTime + 1.0/refreshFps - GetTime();
+    if (remaining > 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+}
+
+#if defined(TRACK_MEMORY)
+// Report of the screen just unloaded, its high-water marks cover its whole run
+static void TraceScreenMemory(GameScreen screen)
+{
+    TraceMemoryReport(TextFormat("%s screen unloaded", screenNames[screen]));
+    ResetMemoryHighWater();
+}
+#endif
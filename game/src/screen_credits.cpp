@@ -25,6 +25,8 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "tick_input.h"
+#include "layer_cache.h"
 
 #define STANDARD_TITLE_SPACING 4.0f
 //----------------------------------------------------------------------------------
@@ -32,6 +34,7 @@
 //----------------------------------------------------------------------------------
 static int framesCounter = 0;
 static int finishScreen = 0;
+static LayerCache creditsLayer = { 0 };     // Whole screen, nothing in it changes
 
 
 //----------------------------------------------------------------------------------
@@ -53,7 +56,7 @@ void UpdateCreditsScreen(void)
     // TODO: Update Credits screen variables here!
 
     // Press enter or tap to change to ENDING screen
-    if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP))
+    if (IsKeyPressedTick(KEY_ENTER) || IsTapDetectedTick())
     {
         finishScreen = 1;
         PlaySound(fxCoin);
@@ -63,33 +66,46 @@ void UpdateCreditsScreen(void)
 
 static void DrawTextExCentered(Font font, const char* text, float fontSize, float spacing, Color tint, int offsetY)
 {
+    Vector2 size = MeasureTextEx(font, text, fontSize, spacing);
     Vector2 position;
-    position.x = GetScreenWidth() / 2 - MeasureTextEx(font, text, fontSize, spacing).x / 2 ;
-    position.y = GetScreenHeight() / 2 - MeasureTextEx(font, text, fontSize, spacing).y / 2 + offsetY;
+    position.x = GetScreenWidth() / 2 - size.x / 2;
+    position.y = GetScreenHeight() / 2 - size.y / 2 + offsetY;
     DrawTextEx(font, text, position, fontSize, spacing, tint);
 }
 
-// Credits Screen Draw logic
-void DrawCreditsScreen(void)
+// Whole credits screen, rendered into creditsLayer
+static void drawCreditsLayer(void)
 {
-    // TODO: Draw Credits screen here!
     DrawTexturePro(backgroundImage, { 0.0f, 0.0f, (float)backgroundImage.width, (float)backgroundImage.height }, FULL_SCREEN_RECTANGLE, { 0, 0 }, 0, WHITE);
-    Vector2 pos = { 20, 10 };
     DrawTextExCentered(font, "Coded by: Francisco Jose Palacios Marquez", TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, 0);
     DrawTextExCentered(font, "Press enter to go back to the main menu", TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, 50);
 
 }
 
+// Credits Screen Draw logic
+void DrawCreditsScreen(void)
+{
+    // TODO: Draw Credits screen here!
+    DrawLayerCache(&creditsLayer, 0, drawCreditsLayer);
+}
+
 
 
 // Credits Screen Unload logic
 void UnloadCreditsScreen(void)
 {
     // TODO: Unload Credits screen variables here!
+    UnloadLayerCache(&creditsLayer);
 }
 
 // Credits Screen should finish?
 int FinishCreditsScreen(void)
 {
     return finishScreen;
+}
+
+// Credits Screen render rate, nothing moves
+ScreenRefresh GetCreditsScreenRefresh(void)
+{
+    return REFRESH_ON_DEMAND;
 }
\ No newline at end of file
@@ -25,6 +25,9 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "tick_input.h"
+#include "layer_cache.h"
+#include "simulation.h"             // Required for: SIM_TICKS_PER_SECOND
 
 
 
@@ -33,8 +36,11 @@
 //----------------------------------------------------------------------------------
 static int framesCounter = 0;
 static int finishScreen = 0;
-static int highScorePoints = 0;
-static int highScoreTime = 0;
+static LeaderboardTop leaderboardTop = { 0 };
+static int runRank = -1;            // Run that just ended, highlighted when it made the top
+static LayerCache endingLayer = { 0 };  // Whole screen, rendered again when the ranking changes
+
+#define RANKING_SHOWN_COUNT 5
 
 //----------------------------------------------------------------------------------
 // Ending Screen Functions Definition
@@ -47,9 +53,9 @@ void InitEndingScreen(void)
     framesCounter = 0;
     finishScreen = 0;
 
-    //Loading high scores
-    highScorePoints = LoadStorageValue(1);
-    highScoreTime = LoadStorageValue(0);
+    //Loading rankings, the index keeps them ready whatever the number of recorded runs
+    leaderboardTop = GetLeaderboardTop();
+    runRank = GetLastLeaderboardRank();
 }
 
 
@@ -60,14 +66,14 @@ void UpdateEndingScreen(void)
     // TODO: Update ENDING screen variables here!
 
     // Press enter or tap to return to TITLE screen
-    if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP))
+    if (IsKeyPressedTick(KEY_ENTER) || IsTapDetectedTick())
     {
         finishScreen = 3;
         PlaySound(fxCoin);
     }
 
 
-    if (IsKeyPressed(KEY_Q))
+    if (IsKeyPressedTick(KEY_Q))
     {
         finishScreen = 1;
         PlaySound(fxCoin);
@@ -77,33 +83,61 @@ void UpdateEndingScreen(void)
 
 static void DrawTextExCentered(Font font, const char* text, float fontSize, float spacing, Color tint, int offsetY)
 {
+    Vector2 size = MeasureTextEx(font, text, fontSize, spacing);
     Vector2 position;
-    position.x = GetScreenWidth() / 2 - MeasureTextEx(font, text, fontSize, spacing).x / 2;
-    position.y = GetScreenHeight() / 2 - MeasureTextEx(font, text, fontSize, spacing).y / 2 + offsetY;
+    position.x = GetScreenWidth() / 2 - size.x / 2;
+    position.y = GetScreenHeight() / 2 - size.y / 2 + offsetY;
     DrawTextEx(font, text, position, fontSize, spacing, tint);
 }
 
-// Ending Screen Draw logic
-void DrawEndingScreen(void)
+// Whole ending screen, rendered into endingLayer
+static void drawEndingLayer(void)
 {
-    // TODO: Draw ENDING screen here!
     DrawTexturePro(backgroundImage, { 0.0f, 0.0f, (float)backgroundImage.width, (float)backgroundImage.height }, FULL_SCREEN_RECTANGLE, { 0, 0 }, 0, WHITE);
 
-    Vector2 pos = { 20, 10 };
+    int highScorePoints = (leaderboardTop.count > 0)? leaderboardTop.entries[0].score : 0;
+    int highScoreTime = leaderboardTop.longest.ticks / SIM_TICKS_PER_SECOND;
+
+    DrawTextExCentered(font, TextFormat("Highest score: %d", highScorePoints), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, -200);
+    DrawTextExCentered(font, TextFormat("Highest time alive: %02d:%02d", highScoreTime / 60, highScoreTime % 60), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, -150);
+
+    int shownCount = (leaderboardTop.count < RANKING_SHOWN_COUNT)? leaderboardTop.count : RANKING_SHOWN_COUNT;
+    for (int i = 0; i < shownCount; i++)
+    {
+        const LeaderboardEntry &entry = leaderboardTop.entries[i];
+        int seconds = entry.ticks / SIM_TICKS_PER_SECOND;
+
+        DrawTextExCentered(font, TextFormat("%d.  %6d  %02d:%02d", i + 1, entry.score, seconds / 60, seconds % 60), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, (i == runRank)? GOLD : DARKGREEN, -80 + i * 50);
+    }
+
+    if (runRank >= RANKING_SHOWN_COUNT) DrawTextExCentered(font, TextFormat("Your run ranked #%d", runRank + 1), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, GOLD, 180);
 
-    DrawTextExCentered(font, TextFormat("Highest score: %d", highScorePoints), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, 0);
-    DrawTextExCentered(font, TextFormat("Highest time alive: %02d:%02d", (int)highScoreTime / 60, (int)highScoreTime % 60), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, 50);
-    DrawTextExCentered(font, "Press enter to play again, press Q to go the main menu", TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, 100);
+    DrawTextExCentered(font, "Press enter to play again, press Q to go the main menu", TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN, 250);
+}
+
+// Ending Screen Draw logic
+void DrawEndingScreen(void)
+{
+    // TODO: Draw ENDING screen here!
+    // Every saved run is counted, so the count changes whenever the ranking can
+    DrawLayerCache(&endingLayer, (unsigned int)leaderboardTop.runCount, drawEndingLayer);
 }
 
 // Ending Screen Unload logic
 void UnloadEndingScreen(void)
 {
     // TODO: Unload ENDING screen variables here!
+    UnloadLayerCache(&endingLayer);
 }
 
 // Ending Screen should finish?
 int FinishEndingScreen(void)
 {
     return finishScreen;
+}
+
+// Ending Screen render rate, the ranking only changes on init
+ScreenRefresh GetEndingScreenRefresh(void)
+{
+    return REFRESH_ON_DEMAND;
 }
\ No newline at end of file
@@ -25,102 +25,59 @@
 
 #include "raylib.h"
 #include "screens.h"
-#include <math.h>
-#include <vector>
+#include "tick_input.h"
+#include "simulation.h"
+#include "replay.h"
+#include "allocation_counter.h"
+#include "memory_tracker.h"
+#include "asset_cache.h"
+#include "profiler.h"
+#include "particle_system.h"
+#include "sprite_batch.h"
+#include "text_run.h"
+#include "sim_snapshot.h"
+#include "snapshot_history.h"
 #include <time.h>
-#include <stdlib.h>
-#include <string>
-#include <algorithm>
-#include <cmath>
-
-#define SHOT_SQUARE_SIZE 10
-#define SHOT_SPEED 10
-#define PLAYER_SPRITE_OFFSET -90
-#define SHOT_FRAMES_LIFESPAN 180
-#define PLAYER_SHOT_COOLDOWN_FRAMES 60
-#define PLAYER_INVENCIBILITY_FRAMES 60
-#define PLAYER_SPRITE_ALPHA 1
-#define PLAYER_SPRITE_ALPHA_DELTA 0.05
-#define ASTEROID_SPEED 5
-#define POWERUP_FRAMES_LIFESPAN 180
-#define GENERATION_RATE_POWERUP 500
-#define NUMBER_OF_SHOTS_POWERUP 3
-#define MULTIPLE_SHOT_DEVIATION_DEGREES 15
-#define PLAYER_POWERUP_LIFESPAN 500
-
-struct Player {
-    Texture2D sprite;
-    float spriteAlpha;
-    Vector2 position;
-    Vector2 currentInput; 
-    Vector2 spriteCenter; 
-    float rotationDegrees;  
-    float rotationAlpha;
-    float currentSpeed;
-    float speedAlpha;
-    float decelerationRate;
-    bool isShootInCooldown;
-    int lastShootFrameNumber;
-    Rectangle bounds;
-    int lives;
-    int score;
-    bool isShootingKeyActive;
-    int lastDamageFrameCounter;
-    bool isInvulnerable;
-    bool hasPowerUp;
-    int powerUpFramesLeft;
-};
-
-struct Asteroid {
-    Texture2D sprite;
-    Vector2 position;
-    Vector2 spriteCenter;
-    float rotationDegrees;  
-    float currentSpeed;
-    int size;
-    Rectangle bounds;
-    bool isActive;
-};
-
-struct PlayerShot {
-    Vector2 position;
-    Rectangle bounds;
-    float currentSpeed;
-    float rotationDegrees;
-    int frameslifespan;
-    bool isActive;
-};
-
-struct PlayerPowerUp {
-    Texture2D sprite;
-    Vector2 spriteCenter;
-    Vector2 position;
-    Rectangle bounds;
-    int frameslifespan;
-    bool isActive;
-};
+#include <math.h>         // Required for: fabsf(), cosf(), sinf()
+#include <future>         // Required for: std::async(), sprite hulls are traced off the main thread
+
+#define PLAYER_SPRITE_FILE         "resources/textures/SpaceShip.png"
+#define SMALL_METEOR_SPRITE_FILE   "resources/textures/SmallMeteor.png"
+#define MEDIUM_METEOR_SPRITE_FILE  "resources/textures/MendiumMeteor.png"
+#define BIG_METEOR_SPRITE_FILE     "resources/textures/BigMeteor.png"
+#define LIFE_ACTIVE_SPRITE_FILE    "resources/textures/Life_Active.png"
+#define LIFE_INACTIVE_SPRITE_FILE  "resources/textures/Life_Inactive.png"
+#define POWERUP_SPRITE_FILE        "resources/textures/Bonus.png"
+#define SHOT_SOUND_FILE            "resources/Sounds/shot.wav"
+#define GAMEPLAY_MUSIC_FILE        "resources/Music/gameplayMusic.ogg"
+#define EXPLOSION_SOUND_FILE       "resources/Sounds/explosion.wav"
+#define PLAYER_DAMAGED_SOUND_FILE  "resources/Sounds/explosion_small.wav"
+#define ACCELERATION_SOUND_FILE    "resources/Sounds/jump.wav"
+#define PICKUP_SOUND_FILE          "resources/Sounds/CollectBonus.wav"
+
+#define REPLAY_RECORD_FILE "lastSession.replay"     // Every session is recorded here, overwritten by the next one
+#define SHAPE_ALPHA_THRESHOLD 128                   // Pixels at least this opaque are part of a collision shape
+#define PARTICLE_CAPACITY 16384                     // Bursts past it are cut short, the stress field can fill it
+#define PLAYER_EXHAUST_DEGREES 90.0f                // Sprite points up at rotation 0, the trail leaves downwards
+#define REWIND_HISTORY_SECONDS 10.0f
+#define REWIND_INTERVAL_TICKS 30                    // Every rewind step goes back half a second
+
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
 //----------------------------------------------------------------------------------
-static int framesCounter = 0;
 static int finishScreen = 0;
 
-std::vector<Asteroid> asteroidsInStage;
-std::vector<Asteroid> pendingAsteroidsToAdd;
-std::vector<PlayerShot> shotsInStage;
-
-double timeAtInit;
-double elapsedTimeFromLastInit;
-bool isTherePowerUpPresent; 
+GameState gameState;            //Gameplay rules live in the simulation core, this screen only feeds and draws it
 
-//NPatchInfo nPatchBackground;
-Player player;
-PlayerPowerUp powerUp;
+ReplayWriter replayWriter;
+ReplayReader replayReader;
+bool isReplaying;
+bool hasReplayDesynced;
+double replayUpdateTime;        //Accumulated CPU time of the replayed frames, in seconds
+double replayDrawTime;
 
 Texture2D playerSprite;
-Texture2D asteroidSpriteSize1;
-Texture2D asteroidSpriteSize2;
-Texture2D asteroidSpriteSize3; 
+Texture2D asteroidSprites[4];     //Indexed by asteroid size, index 0 unused
 Texture2D lifeActiveSprite;
 Texture2D lifeInctiveSprite;
 Texture2D powerUpSprite;
@@ -131,8 +88,31 @@ Sound accelerationSound;
 Sound playerDamagedSound;
 Sound pickUpSound;
 
-int highScorePoints;
-int highScoreTime;
+CollisionShape playerShape;             //Built from the sprite alpha once, sprites never change
+CollisionShape asteroidShapes[4];
+bool areShapesGenerated = false;
+std::future<void> shapesGenerated;      //Started by the preload, waited for by the first init
+
+ParticleSystem particles;
+
+SpriteBatch spriteBatch;
+std::vector<SpriteTransform> asteroidTransforms[4];     //Indexed by asteroid size, refilled every frame
+
+TextRun scoreTextRun;           //HUD texts are only formatted and laid out again when their value changes
+TextRun timeTextRun;
+int hudScore;
+int hudSeconds;
+
+SimSnapshot startSnapshot;      //Taken right after the simulation init, restarting restores it
+SimSnapshot checkpointSnapshot;
+bool hasCheckpoint;
+SnapshotHistory rewindHistory;
+bool canEditTimeline;           //Restart, rewind and checkpoints, off for replays and stress runs
+
+//Debris count scales with the asteroid size
+static const ParticleEmitter debrisEmitter = { 12, 360.0f, 0.5f, 4.0f, 20.0f, 45.0f, 2.0f, 4.0f, { 200, 170, 140, 255 } };
+static const ParticleEmitter thrustEmitter = { 3, 25.0f, 2.0f, 4.0f, 8.0f, 16.0f, 2.0f, 3.0f, { 255, 140, 40, 255 } };
+static const ParticleEmitter sparkleEmitter = { 40, 360.0f, 1.0f, 3.0f, 25.0f, 50.0f, 1.5f, 3.0f, { 255, 220, 80, 255 } };
 
 //----------------------------------------------------------------------------------
 // Gameplay Screen Functions Definition
@@ -142,126 +122,95 @@ Vector2 getSpriteCenter(const Texture2D &sprite)
     return { (float)sprite.width / 2, (float)sprite.height / 2 };
 }
 
-Vector2 generateRandomPositionInScreen(void)
+Vector2 getSpriteSize(const Texture2D &sprite)
 {
-    Vector2 aux = { 0,0 };
-
-    aux.x = rand() % GetScreenWidth() + 1 - GetScreenWidth() / 100;
-    aux.y = rand() % GetScreenHeight() + 1 - GetScreenHeight() / 100; 
-
-    return aux;
+    return { (float)sprite.width, (float)sprite.height };
 }
 
-Vector2 generateRandomPositionInScreenEdge(void)
+// Hull of the opaque pixels, the texture only lives on the GPU so the file is decoded again
+// NOTE: No vertices when the file can not be read, the init falls back to the sprite box
+CollisionShape genSpriteShape(const char *fileName)
 {
-    //Positions only at the edge to avoid spawns inside the player on startup
-    Vector2 aux = { 0,0 };
-    if ((rand() % 2) + 1 == 2)
-    {
-        aux.x = 0;
-        aux.y = rand() % GetScreenHeight() + 1;
-    }
-    else 
-    {
-        aux.x = rand() % GetScreenWidth() + 1;
-        aux.y = 0;  
-    }
-    return aux ;
-}
+    Image image = LoadImage(fileName);
+    if (image.data == NULL) return { 0 };
 
-int generateRandomRotationDegrees(void)
-{
-    return rand() % 360 + 1;
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    CollisionShape shape = GenCollisionShapeFromAlpha((const unsigned char *)image.data + 3, image.width, image.height, 4, SHAPE_ALPHA_THRESHOLD);
+    UnloadImage(image);
+
+    return shape;
 }
 
-void generatePowerUp()
+// Decoding and tracing four sprites is most of the first init, it runs during the fade-in
+void genSpriteShapes(void)
 {
-    powerUp.position = generateRandomPositionInScreen();
-    powerUp.bounds = { (float)powerUp.position.x,(float)powerUp.position.y,(float)powerUp.sprite.width,(float)powerUp.sprite.height };
-
-    powerUp.frameslifespan = POWERUP_FRAMES_LIFESPAN;
-    powerUp.isActive = true;
-    
+    playerShape = genSpriteShape(PLAYER_SPRITE_FILE);
+    asteroidShapes[1] = genSpriteShape(SMALL_METEOR_SPRITE_FILE);
+    asteroidShapes[2] = genSpriteShape(MEDIUM_METEOR_SPRITE_FILE);
+    asteroidShapes[3] = genSpriteShape(BIG_METEOR_SPRITE_FILE);
 }
 
-void generateRandomAsteroid(int instances, Vector2 position, int size)
+void waitSpriteShapes(void)
 {
-    for (int i = 0; i < instances; i++)
-    {
-        Asteroid auxAsteroid;
-
-        if (size == 3) auxAsteroid.sprite = asteroidSpriteSize3;
-        if (size == 2) auxAsteroid.sprite = asteroidSpriteSize2;
-        if (size == 1) auxAsteroid.sprite = asteroidSpriteSize1;
-        auxAsteroid.position = position;
-        auxAsteroid.spriteCenter = getSpriteCenter(auxAsteroid.sprite);
-        auxAsteroid.rotationDegrees = generateRandomRotationDegrees();
-        auxAsteroid.currentSpeed = ASTEROID_SPEED;
-        auxAsteroid.size = size;
-        auxAsteroid.bounds = { (float) auxAsteroid.position.x,(float)auxAsteroid.position.y,(float)auxAsteroid.sprite.width,(float)auxAsteroid.sprite.height };
-        auxAsteroid.isActive = true;
+    if (areShapesGenerated) return;
 
+    if (shapesGenerated.valid()) shapesGenerated.get();
+    else genSpriteShapes();
 
-        pendingAsteroidsToAdd.push_back(auxAsteroid);
+    if (playerShape.vertexCount == 0) playerShape = GenCollisionShapeBox((float)playerSprite.width, (float)playerSprite.height);
+    for (int size = 1; size < 4; size++)
+    {
+        if (asteroidShapes[size].vertexCount == 0) asteroidShapes[size] = GenCollisionShapeBox((float)asteroidSprites[size].width, (float)asteroidSprites[size].height);
     }
-}
 
-void generateRandomAsteroid(int instances)
-{
-    generateRandomAsteroid(instances, generateRandomPositionInScreenEdge(), 3);
+    areShapesGenerated = true;
 }
 
-void LoadResources (void)
+// Queues every gameplay asset for background decoding, called while earlier screens run
+void PreloadGameplayScreen(void)
 {
-    playerSprite        = LoadTexture("resources/textures/SpaceShip.png");
-    asteroidSpriteSize1 = LoadTexture("resources/textures/SmallMeteor.png");
-    asteroidSpriteSize2 = LoadTexture("resources/textures/MendiumMeteor.png");
-    asteroidSpriteSize3 = LoadTexture("resources/textures/BigMeteor.png");
-    lifeActiveSprite    = LoadTexture("resources/textures/Life_Active.png");
-    lifeInctiveSprite   = LoadTexture("resources/textures/Life_Inactive.png");
-    powerUpSprite       = LoadTexture("resources/textures/Bonus.png");
-    shotSound           = LoadSound("resources/Sounds/shot.wav");
-    gameplayMusic       = LoadMusicStream("resources/Music/gameplayMusic.ogg");
-    explosionSound      = LoadSound("resources/Sounds/explosion.wav");
-    playerDamagedSound  = LoadSound("resources/Sounds/explosion_small.wav");
-    accelerationSound   = LoadSound("resources/Sounds/jump.wav");
-    pickUpSound         = LoadSound("resources/Sounds/CollectBonus.wav");
+    PreloadTexture(PLAYER_SPRITE_FILE);
+    PreloadTexture(SMALL_METEOR_SPRITE_FILE);
+    PreloadTexture(MEDIUM_METEOR_SPRITE_FILE);
+    PreloadTexture(BIG_METEOR_SPRITE_FILE);
+    PreloadTexture(LIFE_ACTIVE_SPRITE_FILE);
+    PreloadTexture(LIFE_INACTIVE_SPRITE_FILE);
+    PreloadTexture(POWERUP_SPRITE_FILE);
+    PreloadSound(SHOT_SOUND_FILE);
+    PreloadMusic(GAMEPLAY_MUSIC_FILE);
+    PreloadSound(EXPLOSION_SOUND_FILE);
+    PreloadSound(PLAYER_DAMAGED_SOUND_FILE);
+    PreloadSound(ACCELERATION_SOUND_FILE);
+    PreloadSound(PICKUP_SOUND_FILE);
 
+    if (!areShapesGenerated && !shapesGenerated.valid()) shapesGenerated = std::async(std::launch::async, genSpriteShapes);
 }
 
-void InitializePlayer(void)
+void LoadResources (void)
 {
-    player.sprite = playerSprite;
-    player.position = { (float)GetScreenWidth() / 2 ,(float)GetScreenHeight() / 2 };
-    player.spriteCenter = getSpriteCenter(player.sprite);
-    player.rotationDegrees = 0;
-    player.rotationAlpha = 10.0f;
-    player.speedAlpha = 5.0f;
-    player.decelerationRate = 0.1f;
-    player.currentInput = { 0,0 };
-    player.bounds = { (float)player.position.x,(float)player.position.y,(float)player.sprite.width,(float)player.sprite.height };
-    player.lives = 3;
-    player.score = 0;
-    player.isShootInCooldown = false;
-    player.lastShootFrameNumber = 0;
-    player.lastDamageFrameCounter = 0;
-    player.spriteAlpha = PLAYER_SPRITE_ALPHA;
-    player.isInvulnerable = false;
-    player.hasPowerUp = false;
-    player.powerUpFramesLeft = 0;
+    playerSprite        = AcquireTexture(PLAYER_SPRITE_FILE);
+    asteroidSprites[1]  = AcquireTexture(SMALL_METEOR_SPRITE_FILE);
+    asteroidSprites[2]  = AcquireTexture(MEDIUM_METEOR_SPRITE_FILE);
+    asteroidSprites[3]  = AcquireTexture(BIG_METEOR_SPRITE_FILE);
+    lifeActiveSprite    = AcquireTexture(LIFE_ACTIVE_SPRITE_FILE);
+    lifeInctiveSprite   = AcquireTexture(LIFE_INACTIVE_SPRITE_FILE);
+    powerUpSprite       = AcquireTexture(POWERUP_SPRITE_FILE);
+    shotSound           = AcquireSound(SHOT_SOUND_FILE);
+    gameplayMusic       = AcquireMusic(GAMEPLAY_MUSIC_FILE);
+    explosionSound      = AcquireSound(EXPLOSION_SOUND_FILE);
+    playerDamagedSound  = AcquireSound(PLAYER_DAMAGED_SOUND_FILE);
+    accelerationSound   = AcquireSound(ACCELERATION_SOUND_FILE);
+    pickUpSound         = AcquireSound(PICKUP_SOUND_FILE);
+
 }
 
 // Gameplay Screen Initialization logic
 void InitGameplayScreen(void)
 {
     // TODO: Initialize GAMEPLAY screen variables here!
+    MEMORY_TAG_SCOPE(MEMORY_TAG_GAMEPLAY);    // Assets acquired here are charged by the asset cache
 
 
-    timeAtInit = GetTime();
-
-    srand(time(NULL));
-
-    framesCounter = 0;
     finishScreen = 0;
     LoadResources();
 
@@ -274,252 +223,150 @@ void InitGameplayScreen(void)
     SetSoundVolume(accelerationSound, volumeLevel);
     SetSoundVolume(pickUpSound, volumeLevel);
 
-    InitializePlayer();
+    isReplaying = (replayFileName != NULL) && OpenReplayReader(&replayReader, replayFileName);
+    hasReplayDesynced = false;
+    replayUpdateTime = 0.0;
+    replayDrawTime = 0.0;
 
-    //Initializing asteroids
-    generateRandomAsteroid(rand() % 2 + 1);
+    if (isReplaying)
+    {
+        //Seed and config come from the recording so the run is the same game
+        InitSimulation(&gameState, &replayReader.config, replayReader.seed);
+    }
+    else
+    {
+        if (replayFileName != NULL) TraceLog(LOG_WARNING, "REPLAY: [%s] Could not be opened, playing normally", replayFileName);
 
+        //Hitboxes follow the loaded sprites and the world follows the window
+        SimConfig config = GetDefaultSimConfig();
+        config.worldWidth = (float)GetScreenWidth();
+        config.worldHeight = (float)GetScreenHeight();
+        config.playerSize = getSpriteSize(playerSprite);
+        for (int size = 1; size < 4; size++) config.asteroidSizes[size] = getSpriteSize(asteroidSprites[size]);
+        config.powerUpSize = getSpriteSize(powerUpSprite);
 
-    //Loading high scores
-    highScorePoints = LoadStorageValue(1);
-    highScoreTime = LoadStorageValue(0);
+        waitSpriteShapes();
 
-    powerUp.sprite = powerUpSprite;
-    powerUp.isActive = false;
-    powerUp.bounds = { (float)powerUp.position.x,(float)powerUp.position.y,(float)powerUp.sprite.width,(float)powerUp.sprite.height };
-    powerUp.spriteCenter = getSpriteCenter(powerUp.sprite);
+        config.playerShape = playerShape;
+        for (int size = 1; size < 4; size++) config.asteroidShapes[size] = asteroidShapes[size];
+        if (stressAsteroidCount > 0) SetSimConfigStress(&config, stressAsteroidCount);
 
-}
+        uint64_t seed = (uint64_t)time(NULL);
+        InitSimulation(&gameState, &config, seed);
 
-float degreeToRadians(float degrees)
-{
-    return degrees * PI / 180;
-}
-
-
-void MoveObjectForwards(Vector2 *pos, float rotationDegrees, float speed, float rotationDegreesOffset, Rectangle *bounds)
-{
-    pos->x += speed * cos(degreeToRadians(rotationDegrees + rotationDegreesOffset));
-    pos->y += speed * sin(degreeToRadians(rotationDegrees + rotationDegreesOffset));
+        //Stress sessions would overwrite the last real session, they are not recorded
+        if (stressAsteroidCount > 0) replayWriter.file = NULL;
+        else if (!OpenReplayWriter(&replayWriter, REPLAY_RECORD_FILE, seed, &config)) TraceLog(LOG_WARNING, "REPLAY: [%s] Could not be created, session not recorded", REPLAY_RECORD_FILE);
+    }
 
-    //Moving hitbox
-    bounds->x = pos->x;
-    bounds->y = pos->y; 
+    InitParticleSystem(&particles, PARTICLE_CAPACITY);
+    InitSpriteBatch(&spriteBatch, gameState.config.asteroidCapacity);
+    hudScore = -1;
+    hudSeconds = -1;
+    for (std::vector<SpriteTransform> &transforms : asteroidTransforms) transforms.reserve(gameState.config.asteroidCapacity);
 
-    //Handling moves outside the screen so the object appears through the other side
-    if (pos->x < 0) pos->x += GetScreenWidth();
-    if (pos->y < 0) pos->y += GetScreenHeight();
-    if (pos->x > GetScreenWidth()) pos->x -= GetScreenWidth();
-    if (pos->y > GetScreenHeight()) pos->y -= GetScreenHeight();
+    hasCheckpoint = false;
+    canEditTimeline = !isReplaying && (stressAsteroidCount == 0);
 
+    //Restart point and history are sized for full pools, only sessions that can edit the timeline pay for them
+    if (canEditTimeline)
+    {
+        SaveSimSnapshot(&gameState, &startSnapshot);
+        InitSnapshotHistory(&rewindHistory, &gameState.config, REWIND_HISTORY_SECONDS, REWIND_INTERVAL_TICKS, true);
+    }
 }
 
-void handlePlayerInputs(void)
+SimInput readPlayerInput(void)
 {
-    //We store the inputs as a 2D array
-    //Rotation
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))
-    {
-        player.currentInput.y = -1;
-    }
-    else 
-        if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT))
-        {
-            player.currentInput.y = 1;
-        }
-        else 
-        {
-            player.currentInput.y = 0;
-        }
+    SimInput input = { 0 };
 
+    //Rotation
+    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) input.rotation = -1;
+    else if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) input.rotation = 1;
 
     //Translation
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))
-    {
-        player.currentInput.x = 1;
-        player.currentSpeed = player.speedAlpha;
+    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) input.thrust = 1;
+    else if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) input.thrust = -1;
 
-    }
-    else
-        if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))
-        {
-            player.currentInput.x = -1;
-            player.currentSpeed = -player.speedAlpha;
-        }
-        else
-        {
-            player.currentInput.x = 0;
-        }
-
-    if (IsKeyDown(KEY_SPACE))
-    {
-        player.isShootingKeyActive = true;
-    }
-    else
-    {
-        player.isShootingKeyActive = false;
-    }
+    input.shoot = IsKeyDown(KEY_SPACE);
 
     //Quit
-    if (IsKeyPressed(KEY_Z))
-    {
-        finishScreen = 1;
-    }
+    input.quit = IsKeyPressedTick(KEY_Z);
+
+    return input;
 }
 
-void handleCollisionsAsteroidPlayer(Asteroid &asteroid, Player &player)
+// A rewound or reloaded game no longer matches its recording, which is kept up to this point
+void stopRecording(void)
 {
+    if (replayWriter.file == NULL) return;
 
-    if (CheckCollisionRecs(asteroid.bounds, player.bounds))
-    {
-
-        if (framesCounter - player.lastDamageFrameCounter >= PLAYER_INVENCIBILITY_FRAMES)
-        {
-            if (player.lives == 1)
-            {
-                finishScreen = 1;
-                if (highScorePoints < player.score) SaveStorageValue(1, player.score);
-                if (highScoreTime < elapsedTimeFromLastInit) SaveStorageValue(0, elapsedTimeFromLastInit);
-            }
-
-            player.lives--;
-            player.lastDamageFrameCounter = framesCounter;
-            PlaySound(playerDamagedSound);
-            player.isInvulnerable = true;
-
-        }
-
-    }
+    CloseReplayWriter(&replayWriter);
+    TraceLog(LOG_INFO, "REPLAY: [%s] Timeline changed, recording stopped at frame %i", REPLAY_RECORD_FILE, replayWriter.frames);
 }
 
-void handleCollisionsPowerUpPlayer(PlayerPowerUp& powerUp, Player& player)
+// Restart, rewind and checkpoint keys, every one of them is a single snapshot copy
+void handleTimelineKeys(void)
 {
-
-    if (powerUp.isActive && CheckCollisionRecs(powerUp.bounds, player.bounds))
+    if (IsKeyPressedTick(KEY_R))
     {
+        LoadSimSnapshot(&gameState, startSnapshot.data.data(), startSnapshot.size);
+        ClearSnapshotHistory(&rewindHistory);
+        ClearParticles(&particles);
 
-        player.hasPowerUp = true;
-        powerUp.isActive = false;
-        player.powerUpFramesLeft = PLAYER_POWERUP_LIFESPAN;
-        PlaySound(pickUpSound);
+        //Same seed and config as the first start, so the new recording replays from the top
+        CloseReplayWriter(&replayWriter);
+        if (!OpenReplayWriter(&replayWriter, REPLAY_RECORD_FILE, gameState.seed, &gameState.config)) TraceLog(LOG_WARNING, "REPLAY: [%s] Could not be created, session not recorded", REPLAY_RECORD_FILE);
     }
-}
-
-void handleCollisionsAsteroidShot(Asteroid& asteroid, PlayerShot& shot)
-{
-
-    if (CheckCollisionRecs(asteroid.bounds, shot.bounds) && asteroid.isActive && shot.isActive)
+    else if (IsKeyPressedTick(KEY_BACKSPACE))
     {
-        if (asteroid.size == 3)
-        {
-            asteroid.size = 2;
-            asteroid.sprite = asteroidSpriteSize2;
-            player.score += 10;
-
-
-            generateRandomAsteroid(3, asteroid.position, 2);
-        }
-        else {
-            if (asteroid.size == 2)
-            {
-                asteroid.size = 1;
-                player.score += 20;
-                generateRandomAsteroid(3, asteroid.position, 1);
-
-            }
-            else
-            {
-                if (asteroid.size == 1)
-                {
-                    player.score += 30;
-                }
-            }
-        }
-        
-        asteroid.isActive = false;
-        shot.isActive = false;
-        PlaySound(explosionSound);
-
+        if (RewindSnapshotHistory(&rewindHistory, &gameState)) stopRecording();
     }
-}
-
-void handleShotsCollisions()
-{
-    for (auto& shot : shotsInStage)
+    else if (IsKeyPressedTick(KEY_F5))
     {
-        for (auto& asteroid : asteroidsInStage)
-        {
-            handleCollisionsAsteroidShot(asteroid, shot);
-        }
+        SaveSimSnapshot(&gameState, &checkpointSnapshot);
+        hasCheckpoint = true;
+        TraceLog(LOG_INFO, "GAMEPLAY: Checkpoint saved at frame %i (%i bytes)", checkpointSnapshot.framesCounter, checkpointSnapshot.size);
     }
-}
-
-void handlePlayerCollisions()
-{
-    for (auto& asteroid : asteroidsInStage)
+    else if (IsKeyPressedTick(KEY_F9) && hasCheckpoint)
     {
-        handleCollisionsAsteroidPlayer(asteroid, player);
+        LoadSimSnapshot(&gameState, checkpointSnapshot.data.data(), checkpointSnapshot.size);
+        ClearSnapshotHistory(&rewindHistory);
+        stopRecording();
     }
-
-    handleCollisionsPowerUpPlayer(powerUp,player);
 }
 
-void generatePlayerShot(static Player& player, bool isPowerUpActive)
+void emitParticleEffects(void)
 {
-    PlayerShot newShot;
-    newShot.position = player.position;
-    newShot.rotationDegrees = player.rotationDegrees;
-    Rectangle shotRectangle = { (float)newShot.position.x,(float)newShot.position.y, (float)SHOT_SQUARE_SIZE,(float)SHOT_SQUARE_SIZE };
-    newShot.bounds = shotRectangle;
-    newShot.currentSpeed = SHOT_SPEED;
+    PROFILE_SCOPE("EmitParticles");
 
-    newShot.frameslifespan = SHOT_FRAMES_LIFESPAN;
-    newShot.isActive = true;
-    shotsInStage.push_back(newShot);
+    const Player &player = gameState.player;
+    unsigned int events = gameState.events;
 
+    for (const SimHit &hit : gameState.hits)
+    {
+        for (int size = 0; size < hit.size; size++) EmitParticles(&particles, &debrisEmitter, hit.position, 0.0f);
+    }
 
-    if (isPowerUpActive)
+    if (events & SIM_EVENT_THRUST)
     {
-        for (int i = - MULTIPLE_SHOT_DEVIATION_DEGREES; i < (NUMBER_OF_SHOTS_POWERUP - 1) * MULTIPLE_SHOT_DEVIATION_DEGREES; i+= MULTIPLE_SHOT_DEVIATION_DEGREES * 2)
-        {
-            PlayerShot newShot;
-            newShot.position = player.position;
-            newShot.rotationDegrees = player.rotationDegrees + i;
-            Rectangle shotRectangle = { (float)newShot.position.x,(float)newShot.position.y, (float)SHOT_SQUARE_SIZE,(float)SHOT_SQUARE_SIZE };
-            newShot.bounds = shotRectangle;
-            newShot.currentSpeed = SHOT_SPEED;
-
-            newShot.frameslifespan = SHOT_FRAMES_LIFESPAN;
-            newShot.isActive = true;
-            shotsInStage.push_back(newShot);
-        }
+        //Out of the tail, or out of the nose when reversing
+        float exhaustDegrees = player.rotationDegrees + ((player.currentInput.x < 0)? -PLAYER_EXHAUST_DEGREES : PLAYER_EXHAUST_DEGREES);
+        float exhaustRadians = exhaustDegrees*DEG2RAD;
+        Vector2 exhaust = { player.position.x + cosf(exhaustRadians)*playerSprite.height/2, player.position.y + sinf(exhaustRadians)*playerSprite.height/2 };
 
+        EmitParticles(&particles, &thrustEmitter, exhaust, exhaustDegrees);
     }
 
+    if (events & SIM_EVENT_POWERUP_PICKED) EmitParticles(&particles, &sparkleEmitter, player.position, 0.0f);
 }
 
-
-
-void handlePlayerMovement(void)
+void handleSimulationEvents(void)
 {
+    unsigned int events = gameState.events;
 
-    //Rotation
-    player.rotationDegrees += player.currentInput.y * player.rotationAlpha;
-    //Translation
-    MoveObjectForwards(&player.position, player.rotationDegrees, player.speedAlpha * player.currentInput.x, PLAYER_SPRITE_OFFSET, &player.bounds);
-
-
-    //Gradual deceleration when no movement input is applied
-    if (player.currentInput.x == 0)
+    if (events & SIM_EVENT_THRUST)
     {
-        if (player.currentSpeed > 0) player.currentSpeed -= player.decelerationRate;
-        if (player.currentSpeed < 0) player.currentSpeed += player.decelerationRate;
-
-        MoveObjectForwards(&player.position, player.rotationDegrees, player.currentSpeed, PLAYER_SPRITE_OFFSET, &player.bounds);
-    }
-    else
-    {
-
         if (!IsSoundPlaying(accelerationSound))
         {
             SetSoundPitch(accelerationSound,10);
@@ -527,139 +374,96 @@ void handlePlayerMovement(void)
         }
     }
 
-    if (framesCounter - player.lastDamageFrameCounter >= PLAYER_INVENCIBILITY_FRAMES && player.lastDamageFrameCounter != 0)
-    {
-        player.isInvulnerable = false;
-        player.spriteAlpha = 1;
-    }
-
-    if (player.isInvulnerable)
-    {
-        player.spriteAlpha -= PLAYER_SPRITE_ALPHA_DELTA;
-        if (player.spriteAlpha <= 0) player.spriteAlpha = 1;
-    }
-
-
-    //We allow the player to shoot again if the cooldown time has passed
-    if (framesCounter - player.lastShootFrameNumber >= PLAYER_SHOT_COOLDOWN_FRAMES || player.lastShootFrameNumber == 0)
-    {
-        player.isShootInCooldown = false;
-    }
-
-    //Player shot logic
-    if (player.isShootingKeyActive && !player.isShootInCooldown)
-    {
-        generatePlayerShot(player,player.hasPowerUp);
-        player.isShootInCooldown = true;
-        PlaySound(shotSound);
-        player.lastShootFrameNumber = framesCounter;
-    }
+    if (events & SIM_EVENT_SHOT) PlaySound(shotSound);
+    if (events & SIM_EVENT_ASTEROID_HIT) PlaySound(explosionSound);
+    if (events & SIM_EVENT_PLAYER_DAMAGED) PlaySound(playerDamagedSound);
+    if (events & SIM_EVENT_POWERUP_PICKED) PlaySound(pickUpSound);
 
-    if (player.hasPowerUp)
+    //Replays were ranked when they were played, stress runs are not real games
+    if ((events & SIM_EVENT_GAME_OVER) && !isReplaying && (stressAsteroidCount == 0))
     {
-        if(player.powerUpFramesLeft > 0 ) player.powerUpFramesLeft--;
-        else
-        {
-            player.hasPowerUp = false;
-        }
+        SaveLeaderboardRun(gameState.player.score, (unsigned int)gameState.framesCounter, gameState.seed);
     }
 
+    if (gameState.isFinished) finishScreen = 1;
 }
 
-void handleAsteroidsMovement(void)
-{
-    for (auto& asteroid : asteroidsInStage)
-    {
-        MoveObjectForwards(&asteroid.position, asteroid.rotationDegrees, asteroid.currentSpeed, 0, &asteroid.bounds);
-    }
-}
-
-
-
-void handleShotsMovement(void)
+// Gameplay Screen Update logic
+void UpdateGameplayScreen(void)
 {
+    MEMORY_TAG_SCOPE(MEMORY_TAG_GAMEPLAY);
 
-    for (auto& shot : shotsInStage)
-    {
-        shot.frameslifespan--;
-        MoveObjectForwards(&shot.position, shot.rotationDegrees, shot.currentSpeed, PLAYER_SPRITE_OFFSET, &shot.bounds);
-    }
+#if defined(COUNT_HEAP_ALLOCATIONS)
+    unsigned long long allocationsAtFrameStart = GetHeapAllocationCount();
+#endif
 
-    shotsInStage.erase(std::remove_if(shotsInStage.begin(), shotsInStage.end(),
-        [](PlayerShot shot) { return shot.frameslifespan <= 0; }), shotsInStage.end());
-}
+    double updateStartTime = GetTime();
+    SimInput input = { 0 };
+    uint32_t recordedHash = 0;
 
-void handleNumberOfAsteroids(void)
-{
-    if (asteroidsInStage.size() == 0)
+    if (isReplaying && !ReadReplayFrame(&replayReader, &input, &recordedHash))
     {
-        generateRandomAsteroid(rand() % 4 + 1);
+        //End of the recording
+        finishScreen = 1;
+        return;
     }
-
-    for (auto &ast: pendingAsteroidsToAdd)
+    else if (!isReplaying)
     {
-        asteroidsInStage.push_back(ast);
+        if (canEditTimeline) handleTimelineKeys();
+        input = readPlayerInput();
     }
 
-    pendingAsteroidsToAdd.clear();
-}
+    StepSimulation(&gameState, input);
+    if (canEditTimeline) UpdateSnapshotHistory(&rewindHistory, &gameState);
 
-void checkElementsToRemove(void)
-{
-    /*asteroidsInStage.erase(std::find_if(asteroidsInStage.begin(), asteroidsInStage.end(),
-        [](Asteroid ast) { return !ast.isActive }));
+#if defined(COUNT_HEAP_ALLOCATIONS)
+    //Pools and scratch buffers are sized at init, a gameplay frame must never reach the heap
+    unsigned long long frameAllocations = GetHeapAllocationCount() - allocationsAtFrameStart;
+    if (frameAllocations > 0) TraceLog(LOG_WARNING, "GAMEPLAY: Frame %i made %llu heap allocations", gameState.framesCounter, frameAllocations);
+#endif
 
-    shotsInStage.erase(std::find_if(shotsInStage.begin(), shotsInStage.end(),
-        [](const auto& sh) { return &sh == &shot; }));
-    */
+    //The hash walks every entity, only pay for it when a replay is written or checked
+    if (isReplaying || (replayWriter.file != NULL))
+    {
+        uint32_t stateHash = GetSimulationHash(&gameState);
 
-    asteroidsInStage.erase(std::remove_if(asteroidsInStage.begin(), asteroidsInStage.end(), [](const Asteroid& ast) { return !ast.isActive; }), asteroidsInStage.end());
-    shotsInStage.erase(std::remove_if(shotsInStage.begin(), shotsInStage.end(), [](const PlayerShot& sh) { return !sh.isActive; }), shotsInStage.end());
+        if (!isReplaying) WriteReplayFrame(&replayWriter, input, stateHash);
+        else if ((stateHash != recordedHash) && !hasReplayDesynced)
+        {
+            TraceLog(LOG_WARNING, "REPLAY: Desync at frame %i (recorded %08x, replayed %08x)", replayReader.frames, recordedHash, stateHash);
+            hasReplayDesynced = true;
+        }
+    }
 
-}
+    handleSimulationEvents();
+    emitParticleEffects();
 
-void handlePowerUp(void)
-{
-    //Chance of 50% after GENERATION_RATE_POWERUP number of frames
-    if (!powerUp.isActive && (rand() % 2) + 1 == 2 && framesCounter % GENERATION_RATE_POWERUP == 0)
     {
-        generatePowerUp();
+        PROFILE_SCOPE("UpdateParticles");
+        UpdateParticles(&particles);
     }
 
-    if (powerUp.isActive)
     {
-        if(powerUp.frameslifespan > 0) powerUp.frameslifespan--;
-        else 
-        {
-            powerUp.isActive = false;
-        }
+        PROFILE_SCOPE("UpdateMusicStream");
+        UpdateMusicStream(gameplayMusic);
     }
-        
-}
-// Gameplay Screen Update logic
-void UpdateGameplayScreen(void)
-{
 
-    handlePlayerInputs();
-    handlePlayerMovement();
-    handleShotsMovement();
-    handlePowerUp();
-    handleAsteroidsMovement();
-    handleShotsCollisions();
-    handlePlayerCollisions();
-    handleNumberOfAsteroids();
-    checkElementsToRemove();
-    UpdateMusicStream(gameplayMusic);
-     elapsedTimeFromLastInit = GetTime() - timeAtInit;
+    if (isReplaying) replayUpdateTime += GetTime() - updateStartTime;
+}
 
 
+// Blends the last two ticks, snapping instead of sweeping across the screen on a wrap
+float interpolateWrapped(float previous, float current, float worldSize)
+{
+    if (fabsf(current - previous) > worldSize/2) return current;
 
-    
+    return previous + (current - previous)*renderInterpolation;
 }
 
-
 void DrawBackground(void)
 {
+    PROFILE_SCOPE("DrawBackground");
+
     //DrawTextureNPatch(backgroundImage, nPatchBackground, FULL_SCREEN_RECTANGLE, (Vector2) { 0, 0 }, 0, WHITE);
     DrawTexturePro(backgroundImage, { 0.0f, 0.0f, (float) backgroundImage.width, (float)backgroundImage.height }, FULL_SCREEN_RECTANGLE, { 0, 0 }, 0, WHITE);
 
@@ -667,14 +471,25 @@ void DrawBackground(void)
 
 void DrawPlayer(void)
 {
-    DrawTexturePro(player.sprite, { 0.0f, 0.0f, (float)player.sprite.width, (float)player.sprite.height }, { player.position.x, player.position.y, (float)player.sprite.width, (float)player.sprite.height }, player.spriteCenter, player.rotationDegrees, Fade(WHITE, player.spriteAlpha));
+    PROFILE_SCOPE("DrawPlayer");
+
+    const Player &player = gameState.player;
+    float positionX = interpolateWrapped(player.previousPosition.x, player.position.x, gameState.config.worldWidth);
+    float positionY = interpolateWrapped(player.previousPosition.y, player.position.y, gameState.config.worldHeight);
+    float rotationDegrees = player.previousRotationDegrees + (player.rotationDegrees - player.previousRotationDegrees)*renderInterpolation;
+
+    DrawTexturePro(playerSprite, { 0.0f, 0.0f, (float)playerSprite.width, (float)playerSprite.height }, { positionX, positionY, (float)playerSprite.width, (float)playerSprite.height }, getSpriteCenter(playerSprite), rotationDegrees, Fade(WHITE, player.spriteAlpha));
 }
 
 void DrawPowerUp(void)
 {
+    PROFILE_SCOPE("DrawPowerUp");
+
+    const PlayerPowerUp &powerUp = gameState.powerUp;
+
     if (powerUp.isActive)
     {
-        DrawTexturePro(powerUp.sprite, { 0.0f, 0.0f, (float)powerUp.sprite.width, (float)powerUp.sprite.height }, { powerUp.position.x, powerUp.position.y, (float)powerUp.sprite.width, (float)powerUp.sprite.height }, powerUp.spriteCenter, 0, WHITE);
+        DrawTexturePro(powerUpSprite, { 0.0f, 0.0f, (float)powerUpSprite.width, (float)powerUpSprite.height }, { powerUp.position.x, powerUp.position.y, (float)powerUpSprite.width, (float)powerUpSprite.height }, getSpriteCenter(powerUpSprite), 0, WHITE);
     }
 
 }
@@ -682,27 +497,62 @@ void DrawPowerUp(void)
 
 void DrawAsteroids(void)
 {
-    for (auto& asteroid : asteroidsInStage)
+    PROFILE_SCOPE("DrawAsteroids");
+
+    const AsteroidStore &asteroids = gameState.asteroids;
+    float tickRemainder = 1.0f - renderInterpolation;
+
+    for (std::vector<SpriteTransform> &transforms : asteroidTransforms) transforms.clear();
+
+    for (int i = 0; i < GetAsteroidCount(asteroids); i++)
     {
-        DrawTexturePro(asteroid.sprite, { 0.0f, 0.0f, (float)asteroid.sprite.width, (float)asteroid.sprite.height }, { asteroid.position.x, asteroid.position.y, (float)asteroid.sprite.width, (float)asteroid.sprite.height }, asteroid.spriteCenter, asteroid.rotationDegrees, WHITE);
+        //Render data is shared per size instead of stored in every asteroid
+        const Texture2D &sprite = asteroidSprites[asteroids.size[i]];
+
+        //Velocity is constant, so the previous tick position is one step back
+        float positionX = asteroids.positionX[i] - asteroids.velocityX[i]*tickRemainder;
+        float positionY = asteroids.positionY[i] - asteroids.velocityY[i]*tickRemainder;
+
+        asteroidTransforms[asteroids.size[i]].push_back({ positionX, positionY, (float)sprite.width, (float)sprite.height, asteroids.rotationDegrees[i] });
 
         //Hitbox debug
-        //DrawRectanglePro( asteroid.bounds, asteroid.spriteCenter,asteroid.rotationDegrees, BLUE);
+        //DrawRectanglePro( asteroids.bounds[i], getSpriteCenter(sprite), asteroids.rotationDegrees[i], BLUE);
+    }
+
+    //One submission per sprite instead of one DrawTexturePro() per asteroid
+    for (int size = 1; size < 4; size++)
+    {
+        const std::vector<SpriteTransform> &transforms = asteroidTransforms[size];
+        DrawTextureProBatch(&spriteBatch, asteroidSprites[size], transforms.data(), NULL, NULL, (int)transforms.size(), getSpriteCenter(asteroidSprites[size]));
     }
 
 }
 
 void DrawShots(void)
 {
-    for (auto& shot : shotsInStage)
+    PROFILE_SCOPE("DrawShots");
+
+    const ShotStore &shots = gameState.shots;
+    float tickRemainder = 1.0f - renderInterpolation;
+
+    for (int i = 0; i < GetShotCount(shots); i++)
     {
-        DrawRectanglePro(shot.bounds,{0,0}, shot.rotationDegrees, RED);
+        Rectangle bounds = shots.bounds[i];
+        bounds.x -= shots.velocityX[i]*tickRemainder;
+        bounds.y -= shots.velocityY[i]*tickRemainder;
+
+        DrawRectanglePro(bounds,{0,0}, shots.rotationDegrees[i], RED);
     }
 
 }
 
 void DrawHUD(void)
 {
+    PROFILE_SCOPE("DrawHUD");
+
+    const Player &player = gameState.player;
+    int elapsedTime = (int)GetSimulationTime(&gameState);
+
     //lives
     for (int i = 0; i < 3; i++)
     {
@@ -710,11 +560,21 @@ void DrawHUD(void)
         DrawTexturePro(spriteToDraw, { 0.0f, 0.0f, (float)spriteToDraw.width, (float)spriteToDraw.height }, { (float)GetScreenWidth() / 100 + i*50, (float)GetScreenHeight() / 100, (float)spriteToDraw.width, (float)spriteToDraw.height }, { 0, 0 }, 0, WHITE);
     }
     //Score
-    DrawTextEx(font, TextFormat("Score: %d",player.score) , {(float)GetScreenWidth() / 8 , (float)GetScreenHeight() / 100}, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, WHITE);
+    if (player.score != hudScore)
+    {
+        hudScore = player.score;
+        UpdateTextRun(&scoreTextRun, font, TextFormat("Score: %d", hudScore), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING);
+    }
+    DrawTextRun(&scoreTextRun, {(float)GetScreenWidth() / 8 , (float)GetScreenHeight() / 100}, WHITE);
 
     //Timer
-    DrawTextEx(font, TextFormat("Time: %02d:%02d", (int)elapsedTimeFromLastInit / 60,  (int) elapsedTimeFromLastInit%60), { (float)GetScreenWidth() / 8  , (float)GetScreenHeight() / 100 + 25 }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, WHITE);
-    
+    if (elapsedTime != hudSeconds)
+    {
+        hudSeconds = elapsedTime;
+        UpdateTextRun(&timeTextRun, font, TextFormat("Time: %02d:%02d", hudSeconds / 60, hudSeconds % 60), TITLE_FONT_SIZE, STANDARD_TITLE_SPACING);
+    }
+    DrawTextRun(&timeTextRun, { (float)GetScreenWidth() / 8  , (float)GetScreenHeight() / 100 + 25 }, WHITE);
+
 
 
 }
@@ -723,13 +583,22 @@ void DrawHUD(void)
 void DrawGameplayScreen(void)
 {
     // TODO: Draw GAMEPLAY screen here!
+    MEMORY_TAG_SCOPE(MEMORY_TAG_GAMEPLAY);
+    double drawStartTime = GetTime();
+
     DrawBackground();
     DrawHUD();
     DrawPlayer();
     DrawAsteroids();
     DrawShots();
     DrawPowerUp();
-    framesCounter++;
+
+    {
+        PROFILE_SCOPE("DrawParticles");
+        DrawParticles(&particles, renderInterpolation);
+    }
+
+    if (isReplaying) replayDrawTime += GetTime() - drawStartTime;
 
 
 }
@@ -742,26 +611,76 @@ void UnloadGameplayScreen(void)
 {
     // TODO: Unload GAMEPLAY screen variables here!
 
-    UnloadTexture(playerSprite);
-    UnloadTexture(asteroidSpriteSize1);
-    UnloadTexture(asteroidSpriteSize2);
-    UnloadTexture(asteroidSpriteSize3);
-    UnloadTexture(lifeActiveSprite);
-    UnloadTexture(lifeInctiveSprite);
-    UnloadTexture(powerUpSprite);
-    UnloadSound(shotSound);
-    UnloadMusicStream(gameplayMusic);
-    UnloadSound(explosionSound);
-    UnloadSound(playerDamagedSound);
-    UnloadSound(accelerationSound);
-
-    asteroidsInStage.clear();
-    shotsInStage.clear();
+    ReleaseTexture(playerSprite);
+    ReleaseTexture(asteroidSprites[1]);
+    ReleaseTexture(asteroidSprites[2]);
+    ReleaseTexture(asteroidSprites[3]);
+    ReleaseTexture(lifeActiveSprite);
+    ReleaseTexture(lifeInctiveSprite);
+    ReleaseTexture(powerUpSprite);
+    ReleaseSound(shotSound);
+    ReleaseMusic(gameplayMusic);
+    ReleaseSound(explosionSound);
+    ReleaseSound(playerDamagedSound);
+    ReleaseSound(accelerationSound);
+    ReleaseSound(pickUpSound);
+
+    UnloadSimulation(&gameState);
+    UnloadParticleSystem(&particles);
+    UnloadSpriteBatch(&spriteBatch);
+    UnloadSnapshotHistory(&rewindHistory);
+
+    if (isReplaying)
+    {
+        int frames = (replayReader.frames > 0)? replayReader.frames : 1;
+
+        TraceLog(LOG_INFO, "REPLAY: [%s] %i frames, %s, update %.3f ms/frame, draw submit %.3f ms/frame", replayFileName, replayReader.frames,
+                 hasReplayDesynced? "DESYNC" : "in sync", replayUpdateTime*1000.0/frames, replayDrawTime*1000.0/frames);
+        CloseReplayReader(&replayReader);
+    }
+    else CloseReplayWriter(&replayWriter);
+
+}
+
+// Gameplay Screen Suspend logic, a game that can be restarted stays loaded while the ending screen shows
+bool SuspendGameplayScreen(void)
+{
+    if (!canEditTimeline) return false;
+
+    StopMusicStream(gameplayMusic);
+    CloseReplayWriter(&replayWriter);       //The finished session is complete on disk
 
+    return true;
+}
+
+// Gameplay Screen Resume logic (Play again), assets, particles, batch and history are reused as they are
+void ResumeGameplayScreen(void)
+{
+    MEMORY_TAG_SCOPE(MEMORY_TAG_GAMEPLAY);
+
+    finishScreen = 0;
+
+    StopMusicStream(music);
+    PlayMusicStream(gameplayMusic);
+
+    //The opening field is drawn from the seed, a new one is rolled on the pools InitSimulation() already sized
+    uint64_t seed = (uint64_t)time(NULL);
+    if (seed == gameState.seed) seed++;
+
+    SimConfig config = gameState.config;
+    InitSimulation(&gameState, &config, seed);
+    SaveSimSnapshot(&gameState, &startSnapshot);
+    ClearSnapshotHistory(&rewindHistory);
+    ClearParticles(&particles);
+    hudScore = -1;
+    hudSeconds = -1;
+    hasCheckpoint = false;
+
+    if (!OpenReplayWriter(&replayWriter, REPLAY_RECORD_FILE, seed, &config)) TraceLog(LOG_WARNING, "REPLAY: [%s] Could not be created, session not recorded", REPLAY_RECORD_FILE);
 }
 
 // Gameplay Screen should finish?
 int FinishGameplayScreen(void)
 {
     return finishScreen;
-}
\ No newline at end of file
+}
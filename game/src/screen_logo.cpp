@@ -25,6 +25,7 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "asset_cache.h"
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
@@ -46,7 +47,7 @@ static int rightSideRecHeight = 0;
 static int state = 0;              // Logo animation states
 static float alpha = 1.0f;         // Useful for fading
 
-static Texture2D backgroundImage = { 0 };
+static Texture2D logoImage = { 0 };
 
 //----------------------------------------------------------------------------------
 // Logo Screen Functions Definition
@@ -69,11 +70,15 @@ void InitLogoScreen(void)
     state = 0;
     alpha = 1.0f;
 
-    backgroundImage = LoadTexture("resources/textures/uoc.png");
+    logoImage = AcquireTexture("resources/textures/uoc.png");
     
 
-    logoPositionX = GetScreenWidth() / 2 - backgroundImage.width/2;
-    logoPositionY = GetScreenHeight() / 2 - backgroundImage.height/2;
+    logoPositionX = GetScreenWidth() / 2 - logoImage.width/2;
+    logoPositionY = GetScreenHeight() / 2 - logoImage.height/2;
+
+    // The logo runs for a few seconds, decode the next screens meanwhile
+    PreloadTitleScreen();
+    PreloadGameplayScreen();
 }
 
 // Logo Screen Update logic
@@ -175,9 +180,9 @@ void DrawLogoScreen(void)
     }*/
 
     //Filling the screen with the logo's color
-    DrawTexturePro(backgroundImage, { 0,0,1,1 }, { 0,0, (float) GetScreenWidth(),(float)GetScreenHeight() },{0,0},0,WHITE);
+    DrawTexturePro(logoImage, { 0,0,1,1 }, { 0,0, (float) GetScreenWidth(),(float)GetScreenHeight() },{0,0},0,WHITE);
 
-    DrawTexture(backgroundImage, logoPositionX, logoPositionY, WHITE);
+    DrawTexture(logoImage, logoPositionX, logoPositionY, WHITE);
 }
 
 // Logo Screen Unload logic
@@ -185,7 +190,7 @@ void UnloadLogoScreen(void)
 {
     // Unload LOGO screen variables here!
 
-    UnloadTexture(backgroundImage);
+    ReleaseTexture(logoImage);
 }
 
 // Logo Screen should finish?
@@ -25,6 +25,8 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "tick_input.h"
+#include "layer_cache.h"
 
 //----------------------------------------------------------------------------------
 // Module Variables Definition (local)
@@ -32,6 +34,7 @@
 static int framesCounter = 0;
 static int finishScreen = 0;
 static int selectedVolume = 0;
+static LayerCache optionsLayer = { 0 };     // Whole screen, rendered again when the volume changes
 
 
 //----------------------------------------------------------------------------------
@@ -55,18 +58,18 @@ void UpdateOptionsScreen(void)
     // TODO: Update Options screen variables here!
 
     // Press enter or tap to change to ENDING screen
-    if (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP))
+    if (IsKeyPressedTick(KEY_ENTER) || IsTapDetectedTick())
     {
         finishScreen = 1;
         PlaySound(fxCoin);
     }
 
-    if (IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT))
+    if (IsKeyPressedTick(KEY_A) || IsKeyPressedTick(KEY_LEFT))
     {
         if(selectedVolume > 0) selectedVolume--;
     }
 
-    if (IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT))
+    if (IsKeyPressedTick(KEY_D) || IsKeyPressedTick(KEY_RIGHT))
     {
         if (selectedVolume < 10) selectedVolume++;
     }
@@ -80,14 +83,15 @@ void UpdateOptionsScreen(void)
 
 static void DrawTextExCentered(Font font, const char* text, float fontSize, float spacing, Color tint, int offsetY)
 {
+    Vector2 size = MeasureTextEx(font, text, fontSize, spacing);
     Vector2 position;
-    position.x = GetScreenWidth() / 2 - MeasureTextEx(font, text, fontSize, spacing).x / 2;
-    position.y = GetScreenHeight() / 2 - MeasureTextEx(font, text, fontSize, spacing).y / 2 + offsetY;
+    position.x = GetScreenWidth() / 2 - size.x / 2;
+    position.y = GetScreenHeight() / 2 - size.y / 2 + offsetY;
     DrawTextEx(font, text, position, fontSize, spacing, tint);
 }
 
-// Options Screen Draw logic
-void DrawOptionsScreen(void)
+// Whole options screen, rendered into optionsLayer
+static void drawOptionsLayer(void)
 {
 
     DrawTexturePro(backgroundImage, { 0.0f, 0.0f, (float)backgroundImage.width, (float)backgroundImage.height }, FULL_SCREEN_RECTANGLE, { 0, 0 }, 0, WHITE);
@@ -99,14 +103,27 @@ void DrawOptionsScreen(void)
 
 }
 
+// Options Screen Draw logic
+void DrawOptionsScreen(void)
+{
+    DrawLayerCache(&optionsLayer, (unsigned int)selectedVolume, drawOptionsLayer);
+}
+
 // Options Screen Unload logic
 void UnloadOptionsScreen(void)
 {
     // TODO: Unload Options screen variables here!
+    UnloadLayerCache(&optionsLayer);
 }
 
 // Options Screen should finish?
 int FinishOptionsScreen(void)
 {
     return finishScreen;
+}
+
+// Options Screen render rate, the volume bar only moves on input
+ScreenRefresh GetOptionsScreenRefresh(void)
+{
+    return REFRESH_ON_DEMAND;
 }
\ No newline at end of file
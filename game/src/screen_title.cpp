@@ -25,6 +25,13 @@
 
 #include "raylib.h"
 #include "screens.h"
+#include "tick_input.h"
+#include "asset_cache.h"
+#include "layer_cache.h"
+
+#define TITLE_IMAGE_FILE "resources/textures/pixil-frame-0.png"
+#define CURSOR_IMAGE_FILE "resources/textures/SpaceShip.png"
+#define CURSOR_SOUND_FILE "resources/Sounds/shot.wav"
 
 #define MAX_OPTIONS 3
 #define PRESS_ENTER_TEXT "PRESS ENTER" 
@@ -49,6 +56,7 @@ static int offsetBetweenMenuOptions = 100;
 static float alpha = 1.0f;         // Useful for fading
 static int cursorIndex = 0;
 static bool hasPressedEntered = false;
+static LayerCache menuLayer = { 0 };    // Background, and the menu once enter was pressed
 
 GameScreen menuOptions[MAX_OPTIONS] = { GAMEPLAY,OPTIONS,CREDITS };
 Texture2D titleImage = { 0 };
@@ -59,6 +67,14 @@ Sound cursorSound = { 0 };
 // Title Screen Functions Definition
 //----------------------------------------------------------------------------------
 
+// Queues the title assets for background decoding
+void PreloadTitleScreen(void)
+{
+    PreloadTexture(TITLE_IMAGE_FILE);
+    PreloadTexture(CURSOR_IMAGE_FILE);
+    PreloadSound(CURSOR_SOUND_FILE);
+}
+
 // Title Screen Initialization logic
 void InitTitleScreen(void)
 {
@@ -68,9 +84,9 @@ void InitTitleScreen(void)
     alpha = 1.0f;
     //hasPressedEntered = false;
 
-    titleImage = LoadTexture("resources/textures/pixil-frame-0.png");
-    cursorImage = LoadTexture("resources/textures/SpaceShip.png");
-    cursorSound = LoadSound("resources/Sounds/shot.wav");
+    titleImage = AcquireTexture(TITLE_IMAGE_FILE);
+    cursorImage = AcquireTexture(CURSOR_IMAGE_FILE);
+    cursorSound = AcquireSound(CURSOR_SOUND_FILE);
 
     SetSoundVolume(cursorSound, volumeLevel);
 
@@ -95,7 +111,7 @@ void UpdateTitleScreen(void)
 {
 
     // Press enter or tap to change to GAMEPLAY screen
-    if (hasPressedEntered && (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP)))
+    if (hasPressedEntered && (IsKeyPressedTick(KEY_ENTER) || IsTapDetectedTick()))
     {
         // Load next screen
         finishScreen = menuOptions[cursorIndex];
@@ -103,7 +119,7 @@ void UpdateTitleScreen(void)
     }
 
     // TODO: Update TITLE screen variables here!
-    if (!hasPressedEntered && (IsKeyPressed(KEY_ENTER) || IsGestureDetected(GESTURE_TAP)))
+    if (!hasPressedEntered && (IsKeyPressedTick(KEY_ENTER) || IsTapDetectedTick()))
     {
         hasPressedEntered = true;
         PlaySound(cursorSound);
@@ -111,7 +127,7 @@ void UpdateTitleScreen(void)
     }
 
 
-    if (hasPressedEntered && (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)))
+    if (hasPressedEntered && (IsKeyPressedTick(KEY_DOWN) || IsKeyPressedTick(KEY_S)))
     {
 
         cursorIndex += 1;
@@ -119,7 +135,7 @@ void UpdateTitleScreen(void)
         PlaySound(fxCoin);
     }
 
-    if (hasPressedEntered && (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)))
+    if (hasPressedEntered && (IsKeyPressedTick(KEY_UP) || IsKeyPressedTick(KEY_W)))
     {
 
         cursorIndex -= 1;
@@ -142,11 +158,24 @@ void UpdateTitleScreen(void)
 }
 
 
+// Static part of the title screen, rendered into menuLayer
+static void drawMenuLayer(void)
+{
+    DrawTexturePro(backgroundImage, { 0.0f, 0.0f, (float)backgroundImage.width, (float)backgroundImage.height }, FULL_SCREEN_RECTANGLE, { 0, 0 }, 0, WHITE);
+
+    if (hasPressedEntered)
+    {
+        DrawTextEx(font, PLAY_TEXT,  { (float) GetScreenWidth() / 2 - MeasureTextEx(font, PLAY_TEXT, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING).x / 2,  (float) pressEnterPositionY }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN);
+        DrawTextEx(font, OPTIONS_TEXT,  { GetScreenWidth() / 2 - MeasureTextEx(font, OPTIONS_TEXT, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING).x / 2,  (float) pressEnterPositionY + offsetBetweenMenuOptions }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN);
+        DrawTextEx(font, CREDITS_TEXT,  { GetScreenWidth() / 2 - MeasureTextEx(font, CREDITS_TEXT, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING).x / 2,  (float) pressEnterPositionY + offsetBetweenMenuOptions * 2 }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN);
+    }
+}
+
 // Title Screen Draw logic
 void DrawTitleScreen(void)
 {
     // TODO: Draw TITLE screen here!
-    DrawTexturePro(backgroundImage, { 0.0f, 0.0f, (float)backgroundImage.width, (float)backgroundImage.height }, FULL_SCREEN_RECTANGLE, { 0, 0 }, 0, WHITE);
+    DrawLayerCache(&menuLayer, (unsigned int)hasPressedEntered, drawMenuLayer);
 
     if (!hasPressedEntered)
     {
@@ -155,9 +184,6 @@ void DrawTitleScreen(void)
 
     if (hasPressedEntered)
     {
-        DrawTextEx(font, PLAY_TEXT,  { (float) GetScreenWidth() / 2 - MeasureTextEx(font, PLAY_TEXT, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING).x / 2,  (float) pressEnterPositionY }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN);
-        DrawTextEx(font, OPTIONS_TEXT,  { GetScreenWidth() / 2 - MeasureTextEx(font, OPTIONS_TEXT, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING).x / 2,  (float) pressEnterPositionY + offsetBetweenMenuOptions }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN);
-        DrawTextEx(font, CREDITS_TEXT,  { GetScreenWidth() / 2 - MeasureTextEx(font, CREDITS_TEXT, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING).x / 2,  (float) pressEnterPositionY + offsetBetweenMenuOptions * 2 }, TITLE_FONT_SIZE, STANDARD_TITLE_SPACING, DARKGREEN);
         DrawTextureEx(cursorImage,  { (float)pressEnterPositionX - cursorImage.width * 2,  (float)pressEnterPositionY + cursorIndex * offsetBetweenMenuOptions }, 0, 1, WHITE);
     }
 
@@ -173,13 +199,23 @@ void DrawTitleScreen(void)
 void UnloadTitleScreen(void)
 {
     // TODO: Unload TITLE screen variables here!
-    //UnloadTexture(titleImage);
-    //UnloadTexture(cursorImage);
-    //UnloadSound(cursorSound);
+    ReleaseTexture(titleImage);
+    ReleaseTexture(cursorImage);
+    ReleaseSound(cursorSound);
+    UnloadLayerCache(&menuLayer);
 }
 
 // Title Screen should finish?
 int FinishTitleScreen(void)
 {
     return finishScreen;
+}
+
+// Title Screen render rate, the menu is static once the logo has landed
+ScreenRefresh GetTitleScreenRefresh(void)
+{
+    if (currentLogoPositionY < finalLogoPositionY) return REFRESH_FULL;
+    if (!hasPressedEntered) return REFRESH_REDUCED;    // Only the press enter text fades
+
+    return REFRESH_ON_DEMAND;
 }
\ No newline at end of file
@@ -26,11 +26,20 @@
 #ifndef SCREENS_H
 #define SCREENS_H
 
+#include "leaderboard.h"
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 typedef enum GameScreen { UNKNOWN = -1, LOGO = 0, TITLE, OPTIONS, GAMEPLAY, ENDING, CREDITS } GameScreen;
 
+// Render rate a screen needs for what it is showing, input and transitions always get full rate
+typedef enum ScreenRefresh {
+    REFRESH_FULL = 0,       // Something moves every frame
+    REFRESH_REDUCED,        // Slow animations only (blinking text)
+    REFRESH_ON_DEMAND       // Nothing moves, redraw on input
+} ScreenRefresh;
+
 //----------------------------------------------------------------------------------
 // Global Variables Declaration (shared by several modules)
 //----------------------------------------------------------------------------------
@@ -40,6 +49,9 @@ extern Music music;
 extern Sound fxCoin;
 extern Texture2D backgroundImage;
 extern float volumeLevel;
+extern const char *replayFileName;
+extern float renderInterpolation;        // 0..1 progress from the previous tick to the current one
+extern int stressAsteroidCount;          // Set with --stress, gameplay then runs the simulation stress mode
 
 #define TITLE_FONT_SIZE font.baseSize * 2.0f
 #define STANDARD_TITLE_SPACING 4.0f
@@ -63,11 +75,13 @@ int FinishLogoScreen(void);
 //----------------------------------------------------------------------------------
 // Title Screen Functions Declaration
 //----------------------------------------------------------------------------------
+void PreloadTitleScreen(void);
 void InitTitleScreen(void);
 void UpdateTitleScreen(void);
 void DrawTitleScreen(void);
 void UnloadTitleScreen(void);
 int FinishTitleScreen(void);
+ScreenRefresh GetTitleScreenRefresh(void);
 
 //----------------------------------------------------------------------------------
 // Options Screen Functions Declaration
@@ -77,15 +91,19 @@ void UpdateOptionsScreen(void);
 void DrawOptionsScreen(void);
 void UnloadOptionsScreen(void);
 int FinishOptionsScreen(void);
+ScreenRefresh GetOptionsScreenRefresh(void);
 
 //----------------------------------------------------------------------------------
 // Gameplay Screen Functions Declaration
 //----------------------------------------------------------------------------------
+void PreloadGameplayScreen(void);
 void InitGameplayScreen(void);
 void UpdateGameplayScreen(void);
 void DrawGameplayScreen(void);
 void UnloadGameplayScreen(void);
 int FinishGameplayScreen(void);
+bool SuspendGameplayScreen(void);       // Stays resident behind the ending screen, false when it cannot restart
+void ResumeGameplayScreen(void);        // Play again, a new game on the resident assets and pools
 
 //----------------------------------------------------------------------------------
 // Ending Screen Functions Declaration
@@ -95,6 +113,7 @@ void UpdateEndingScreen(void);
 void DrawEndingScreen(void);
 void UnloadEndingScreen(void);
 int FinishEndingScreen(void);
+ScreenRefresh GetEndingScreenRefresh(void);
 
 //----------------------------------------------------------------------------------
 // Credits Screen Functions Declaration
@@ -104,11 +123,15 @@ void UpdateCreditsScreen(void);
 void DrawCreditsScreen(void);
 void UnloadCreditsScreen(void);
 int FinishCreditsScreen(void);
+ScreenRefresh GetCreditsScreenRefresh(void);
 
 
-// Persistent storage functions
-bool SaveStorageValue(unsigned int position, int value);
-int LoadStorageValue(unsigned int position);
+// Persistent leaderboard functions, runs are ranked in memory and written behind by a thread
+void InitStorage(void);
+void CloseStorage(void);
+int SaveLeaderboardRun(int score, unsigned int ticks, uint64_t seed);  // Rank in the top, -1 if outside it
+LeaderboardTop GetLeaderboardTop(void);
+int GetLastLeaderboardRank(void);
 
 #ifdef __cplusplus
 }
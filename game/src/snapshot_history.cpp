@@ -0,0 +1,138 @@
+/**********************************************************************************************
+*
+*   Snapshot History - Rolling window of gameplay snapshots for rewind and debugging
+*
+**********************************************************************************************/
+
+#include "snapshot_history.h"
+#include "raylib.h"                 // Required for: MemAlloc(), MemFree()
+#include "sdefl.h"                  // Required for: sdeflate(), sdefl_bound(), built into raylib with SUPPORT_COMPRESSION_API
+#include "sinfl.h"                  // Required for: sinflate(), same
+#include <string.h>                 // Required for: memcpy()
+#include <math.h>                   // Required for: ceilf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SNAPSHOT_DEFLATE_LEVEL 8    // Same level as CompressData()
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static void releaseEntry(SnapshotHistory *history, SnapshotEntry *entry)
+{
+    history->storedBytes -= entry->size;
+    history->rawBytes -= entry->rawSize;
+    entry->size = 0;
+    entry->rawSize = 0;
+    entry->framesCounter = 0;
+}
+
+static bool loadEntry(SnapshotHistory *history, const SnapshotEntry &entry, GameState *state)
+{
+    if (!history->isCompressed) return LoadSimSnapshot(state, entry.data, entry.size);
+
+    SimSnapshot &staging = history->staging;
+    int size = sinflate(staging.data.data(), (int)staging.data.size(), entry.data, entry.size);
+
+    return (size == entry.rawSize) && LoadSimSnapshot(state, staging.data.data(), size);
+}
+
+//----------------------------------------------------------------------------------
+// Snapshot History Functions Definition
+//----------------------------------------------------------------------------------
+void InitSnapshotHistory(SnapshotHistory *history, const SimConfig *config, float seconds, int intervalTicks, bool isCompressed)
+{
+    int capacity = (int)ceilf(seconds*SIM_TICKS_PER_SECOND/intervalTicks);
+    if (capacity < 1) capacity = 1;
+
+    int maxSnapshotSize = GetSimSnapshotMaxSize(config);
+
+    history->intervalTicks = intervalTicks;
+    history->isCompressed = isCompressed;
+    history->slotSize = isCompressed? sdefl_bound(maxSnapshotSize) : maxSnapshotSize;
+    history->buffer.assign((size_t)capacity*history->slotSize, 0);
+    history->entries.resize(capacity);
+    for (int i = 0; i < capacity; i++) history->entries[i] = { history->buffer.data() + (size_t)i*history->slotSize, 0, 0, 0 };
+    history->first = 0;
+    history->count = 0;
+    history->staging.data.resize(maxSnapshotSize);      // SaveSimSnapshot() will not need to grow it
+    history->staging.size = 0;
+    history->compressor = isCompressed? (struct sdefl *)MemAlloc(sizeof(struct sdefl)) : NULL;
+    history->storedBytes = 0;
+    history->rawBytes = 0;
+}
+
+void UnloadSnapshotHistory(SnapshotHistory *history)
+{
+    ClearSnapshotHistory(history);
+
+    MemFree(history->compressor);
+    history->compressor = NULL;
+    history->entries.clear();
+    history->entries.shrink_to_fit();
+    history->buffer.clear();
+    history->buffer.shrink_to_fit();
+    history->staging.data.clear();
+    history->staging.data.shrink_to_fit();
+}
+
+void ClearSnapshotHistory(SnapshotHistory *history)
+{
+    for (SnapshotEntry &entry : history->entries) releaseEntry(history, &entry);
+
+    history->first = 0;
+    history->count = 0;
+    history->storedBytes = 0;
+    history->rawBytes = 0;
+}
+
+void UpdateSnapshotHistory(SnapshotHistory *history, const GameState *state)
+{
+    if ((state->framesCounter%history->intervalTicks) != 0) return;
+
+    int capacity = (int)history->entries.size();
+    SaveSimSnapshot(state, &history->staging);
+
+    // Full ring, the oldest entry makes room
+    if (history->count == capacity)
+    {
+        releaseEntry(history, &history->entries[history->first]);
+        history->first = (history->first + 1)%capacity;
+        history->count--;
+    }
+
+    SnapshotEntry &entry = history->entries[(history->first + history->count)%capacity];
+    entry.rawSize = history->staging.size;
+    entry.framesCounter = state->framesCounter;
+
+    if (history->isCompressed) entry.size = sdeflate(history->compressor, entry.data, history->staging.data.data(), history->staging.size, SNAPSHOT_DEFLATE_LEVEL);
+    else
+    {
+        entry.size = history->staging.size;
+        memcpy(entry.data, history->staging.data.data(), entry.size);
+    }
+
+    history->count++;
+    history->storedBytes += entry.size;
+    history->rawBytes += entry.rawSize;
+}
+
+// Entries taken on the current tick or later (after an earlier rewind) are skipped and dropped
+bool RewindSnapshotHistory(SnapshotHistory *history, GameState *state)
+{
+    int capacity = (int)history->entries.size();
+
+    while (history->count > 0)
+    {
+        SnapshotEntry &newest = history->entries[(history->first + history->count - 1)%capacity];
+        bool isLoaded = (newest.framesCounter < state->framesCounter) && loadEntry(history, newest, state);
+
+        releaseEntry(history, &newest);
+        history->count--;
+
+        if (isLoaded) return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,57 @@
+/**********************************************************************************************
+*
+*   Snapshot History - Rolling window of gameplay snapshots for rewind and debugging
+*
+*   Every intervalTicks the state is saved into a staging SimSnapshot and kept in a ring
+*   covering the last seconds of play, oldest entries dropped first. Entries are optionally
+*   deflated (raylib sdefl, the compressor behind CompressData()): pools are mostly zeros
+*   and repeated sizes, a normal game snapshot shrinks to a fraction of its size.
+*
+*   Every ring slot is sized at init for a full-pool snapshot (its deflate bound when
+*   compressed), compressor state included, so capturing and rewinding never allocate.
+*
+**********************************************************************************************/
+
+#ifndef SNAPSHOT_HISTORY_H
+#define SNAPSHOT_HISTORY_H
+
+#include "sim_snapshot.h"
+#include <stddef.h>                 // Required for: size_t
+#include <vector>
+
+struct sdefl;                       // Deflate state, see external/sdefl.h
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SnapshotEntry {
+    unsigned char *data;            // Fixed slot in the history buffer, compressed or raw
+    int size;
+    int rawSize;                    // Snapshot size before compression
+    int framesCounter;
+} SnapshotEntry;
+
+typedef struct SnapshotHistory {
+    int intervalTicks;
+    bool isCompressed;
+    int slotSize;                           // Worst case entry, full pools
+    std::vector<unsigned char> buffer;      // One slot per entry, allocated at init
+    std::vector<SnapshotEntry> entries;     // Ring, capacity fixed at init
+    int first;                              // Oldest entry
+    int count;
+    SimSnapshot staging;                    // Sized for full pools, also the decompression target
+    struct sdefl *compressor;               // MemAlloc()ed at init when compressing, almost 1MB
+    size_t storedBytes;                     // Kept entries, after compression
+    size_t rawBytes;                        // Same entries, uncompressed
+} SnapshotHistory;
+
+//----------------------------------------------------------------------------------
+// Snapshot History Functions Declaration
+//----------------------------------------------------------------------------------
+void InitSnapshotHistory(SnapshotHistory *history, const SimConfig *config, float seconds, int intervalTicks, bool isCompressed);
+void UnloadSnapshotHistory(SnapshotHistory *history);
+void ClearSnapshotHistory(SnapshotHistory *history);
+void UpdateSnapshotHistory(SnapshotHistory *history, const GameState *state);     // Call once per tick, after the step
+bool RewindSnapshotHistory(SnapshotHistory *history, GameState *state);           // Newest entry older than the state, dropped once restored
+
+#endif // SNAPSHOT_HISTORY_H
@@ -0,0 +1,276 @@
+/**********************************************************************************************
+*
+*   Sprite Batch - Many sprites of one texture in one submission
+*
+**********************************************************************************************/
+
+#include "sprite_batch.h"
+#include "rlgl.h"
+#include "raymath.h"                // Required for: MatrixMultiply()
+#include <math.h>                   // Required for: copysignf()
+#include <string.h>                 // Required for: memcpy()
+#include <algorithm>
+
+#define SPRITE_DRAW_MAX_QUADS 16384     // 65536 vertices, rlDrawVertexArrayElements() takes 16 bit indices
+#define SPRITE_BLOCK_SIZE 64            // Sprites per corner pass, a few KB of stack
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Sine and cosine for sprite corners, error below 1e-5: quarter turn picked by rounding,
+// short series on the [-45, 45] degrees remainder. Quadrant fix-ups are arithmetic, not
+// branches, random rotations would mispredict them and the loop could not vectorize
+static inline void getSinCosDegrees(float degrees, float *sine, float *cosine)
+{
+    float quarters = degrees*(1.0f/90.0f);
+    int quadrant = (int)(quarters + copysignf(0.5f, quarters));     // Nearest, floorf() is a call without SSE4.1
+    float x = (quarters - (float)quadrant)*(PI/2.0f);
+    float x2 = x*x;
+
+    float s = x*(1.0f + x2*(-1.0f/6.0f + x2*(1.0f/120.0f + x2*(-1.0f/5040.0f))));
+    float c = 1.0f + x2*(-0.5f + x2*(1.0f/24.0f + x2*(-1.0f/720.0f + x2*(1.0f/40320.0f))));
+
+    // Two's complement keeps negative quadrants right: 1 swaps, 2 negates both, 3 does both
+    float swap = (float)(quadrant & 1);
+    float sineSign = 1.0f - (float)(quadrant & 2);
+    float cosineSign = 1.0f - (float)((quadrant + 1) & 2);
+
+    *sine = sineSign*(s + (c - s)*swap);
+    *cosine = cosineSign*(c + (s - c)*swap);
+}
+
+static void loadBuffers(SpriteBatch *batch, int capacity)
+{
+    batch->capacity = capacity;
+    batch->defaultQuads = 0;
+    batch->vertices.resize((size_t)capacity*8);
+    batch->texcoords.resize((size_t)capacity*8);
+    batch->colors.resize((size_t)capacity*4);
+
+    // Same quad to triangles split as the rlgl render batch
+    int indexQuads = std::min(capacity, SPRITE_DRAW_MAX_QUADS);
+    std::vector<unsigned short> indices((size_t)indexQuads*6);
+
+    for (int k = 0; k < indexQuads; k++)
+    {
+        indices[k*6 + 0] = (unsigned short)(k*4 + 0);
+        indices[k*6 + 1] = (unsigned short)(k*4 + 1);
+        indices[k*6 + 2] = (unsigned short)(k*4 + 2);
+        indices[k*6 + 3] = (unsigned short)(k*4 + 0);
+        indices[k*6 + 4] = (unsigned short)(k*4 + 2);
+        indices[k*6 + 5] = (unsigned short)(k*4 + 3);
+    }
+
+    batch->vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(batch->vaoId);
+    batch->vboId[0] = rlLoadVertexBuffer(NULL, capacity*8*sizeof(float), true);
+    batch->vboId[1] = rlLoadVertexBuffer(NULL, capacity*8*sizeof(float), true);
+    batch->vboId[2] = rlLoadVertexBuffer(NULL, capacity*4*sizeof(unsigned int), true);
+    batch->vboId[3] = rlLoadVertexBufferElement(indices.data(), indexQuads*6*sizeof(unsigned short), false);
+    rlDisableVertexArray();
+}
+
+static void unloadBuffers(SpriteBatch *batch)
+{
+    for (int i = 0; i < 4; i++) rlUnloadVertexBuffer(batch->vboId[i]);
+    rlUnloadVertexArray(batch->vaoId);
+    batch->vaoId = 0;
+    batch->vboId[0] = batch->vboId[1] = batch->vboId[2] = batch->vboId[3] = 0;
+}
+
+// Quad corners for every sprite, DrawTexturePro() order. Sprites go in blocks: transforms
+// are copied into flat arrays, corners computed over the whole block (fixed trip count, so
+// compilers vectorize it even at -O2), then interleaved into the vertex array
+static void buildCorners(SpriteBatch *batch, const SpriteTransform *transforms, int count, Vector2 origin)
+{
+    float *vertices = batch->vertices.data();
+
+    // Lanes past the last sprite of a block are computed and ignored, zeroed once to stay finite
+    float positionX[SPRITE_BLOCK_SIZE] = { 0 };
+    float positionY[SPRITE_BLOCK_SIZE] = { 0 };
+    float width[SPRITE_BLOCK_SIZE] = { 0 };
+    float height[SPRITE_BLOCK_SIZE] = { 0 };
+    float rotation[SPRITE_BLOCK_SIZE] = { 0 };
+    float cornerX[4][SPRITE_BLOCK_SIZE];
+    float cornerY[4][SPRITE_BLOCK_SIZE];
+
+    for (int first = 0; first < count; first += SPRITE_BLOCK_SIZE)
+    {
+        int blockCount = std::min(count - first, SPRITE_BLOCK_SIZE);
+
+        for (int k = 0; k < blockCount; k++)
+        {
+            const SpriteTransform &transform = transforms[first + k];
+            positionX[k] = transform.x;
+            positionY[k] = transform.y;
+            width[k] = transform.width;
+            height[k] = transform.height;
+            rotation[k] = transform.rotationDegrees;
+        }
+
+        for (int k = 0; k < SPRITE_BLOCK_SIZE; k++)
+        {
+            float sine, cosine;
+            getSinCosDegrees(rotation[k], &sine, &cosine);
+
+            float left = -origin.x;
+            float top = -origin.y;
+            float right = left + width[k];
+            float bottom = top + height[k];
+
+            cornerX[0][k] = positionX[k] + left*cosine - top*sine;         // Top left
+            cornerY[0][k] = positionY[k] + left*sine + top*cosine;
+            cornerX[1][k] = positionX[k] + left*cosine - bottom*sine;      // Bottom left
+            cornerY[1][k] = positionY[k] + left*sine + bottom*cosine;
+            cornerX[2][k] = positionX[k] + right*cosine - bottom*sine;     // Bottom right
+            cornerY[2][k] = positionY[k] + right*sine + bottom*cosine;
+            cornerX[3][k] = positionX[k] + right*cosine - top*sine;        // Top right
+            cornerY[3][k] = positionY[k] + right*sine + top*cosine;
+        }
+
+        for (int k = 0; k < blockCount; k++)
+        {
+            float *v = vertices + (size_t)(first + k)*8;
+
+            for (int corner = 0; corner < 4; corner++)
+            {
+                v[corner*2] = cornerX[corner][k];
+                v[corner*2 + 1] = cornerY[corner][k];
+            }
+        }
+    }
+}
+
+// Texture coordinates and colors of quads [first, count), NULL sources use the whole texture, NULL tints WHITE
+static void buildAttributes(SpriteBatch *batch, Texture2D texture, const Rectangle *sources, const Color *tints, int first, int count)
+{
+    // Missing arrays become one shared element read with a zero stride
+    Rectangle wholeTexture = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    const Rectangle *source = (sources != NULL)? sources : &wholeTexture;
+    int sourceStride = (sources != NULL)? 1 : 0;
+    Color white = WHITE;
+    const Color *tint = (tints != NULL)? tints : &white;
+    int tintStride = (tints != NULL)? 1 : 0;
+
+    float inverseWidth = 1.0f/texture.width;
+    float inverseHeight = 1.0f/texture.height;
+
+    for (int i = first; i < count; i++)
+    {
+        const Rectangle &rect = source[i*sourceStride];
+        float u0 = rect.x*inverseWidth;
+        float v0 = rect.y*inverseHeight;
+        float u1 = (rect.x + rect.width)*inverseWidth;
+        float v1 = (rect.y + rect.height)*inverseHeight;
+
+        float *t = batch->texcoords.data() + (size_t)i*8;
+        t[0] = u0; t[1] = v0;
+        t[2] = u0; t[3] = v1;
+        t[4] = u1; t[5] = v1;
+        t[6] = u1; t[7] = v0;
+
+        unsigned int color;
+        memcpy(&color, &tint[i*tintStride], sizeof(color));
+        unsigned int *c = batch->colors.data() + (size_t)i*4;
+        c[0] = color;
+        c[1] = color;
+        c[2] = color;
+        c[3] = color;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Sprite Batch Functions Definition
+//----------------------------------------------------------------------------------
+void InitSpriteBatch(SpriteBatch *batch, int capacity)
+{
+    loadBuffers(batch, (capacity > 0)? capacity : 1);
+}
+
+void UnloadSpriteBatch(SpriteBatch *batch)
+{
+    unloadBuffers(batch);
+    batch->capacity = 0;
+    batch->vertices.clear();
+    batch->vertices.shrink_to_fit();
+    batch->texcoords.clear();
+    batch->texcoords.shrink_to_fit();
+    batch->colors.clear();
+    batch->colors.shrink_to_fit();
+}
+
+void DrawTextureProBatch(SpriteBatch *batch, Texture2D texture, const SpriteTransform *transforms, const Rectangle *sources, const Color *tints, int count, Vector2 origin)
+{
+    if ((count <= 0) || (texture.id == 0)) return;
+
+    // Grown by doubling, a stress field settles after a few frames
+    if (count > batch->capacity)
+    {
+        int capacity = batch->capacity;
+        while (capacity < count) capacity *= 2;
+
+        unloadBuffers(batch);
+        loadBuffers(batch, capacity);
+    }
+
+    rlDrawRenderBatchActive();          // Earlier draws stay underneath
+
+    buildCorners(batch, transforms, count, origin);
+    rlUpdateVertexBuffer(batch->vboId[0], batch->vertices.data(), count*8*sizeof(float), 0);
+
+    // Whole texture and WHITE give the same coordinates and colors for any texture: once
+    // uploaded they are reused, most calls (asteroids) only send positions
+    bool isDefault = (sources == NULL) && (tints == NULL);
+    int first = isDefault? std::min(batch->defaultQuads, count) : 0;
+
+    if (first < count)
+    {
+        buildAttributes(batch, texture, sources, tints, first, count);
+        rlUpdateVertexBuffer(batch->vboId[1], batch->texcoords.data() + (size_t)first*8, (count - first)*8*sizeof(float), first*8*sizeof(float));
+        rlUpdateVertexBuffer(batch->vboId[2], batch->colors.data() + (size_t)first*4, (count - first)*4*sizeof(unsigned int), first*4*sizeof(unsigned int));
+    }
+
+    batch->defaultQuads = isDefault? std::max(batch->defaultQuads, count) : 0;
+
+    int *locs = rlGetShaderLocsDefault();
+    float diffuse[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    int textureSlot = 0;
+
+    rlEnableShader(rlGetShaderIdDefault());
+    rlSetUniformMatrix(locs[RL_SHADER_LOC_MATRIX_MVP], MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlSetUniform(locs[RL_SHADER_LOC_COLOR_DIFFUSE], diffuse, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locs[RL_SHADER_LOC_MAP_DIFFUSE], &textureSlot, RL_SHADER_UNIFORM_SAMPLER2D, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(texture.id);
+
+    rlEnableVertexArray(batch->vaoId);
+    rlEnableVertexBufferElement(batch->vboId[3]);
+
+    // Indices only reach 65536 vertices, later chunks move the attribute pointers instead
+    for (int first = 0; first < count; first += SPRITE_DRAW_MAX_QUADS)
+    {
+        int quads = std::min(count - first, SPRITE_DRAW_MAX_QUADS);
+        size_t vertex = (size_t)first*4;
+
+        rlEnableVertexBuffer(batch->vboId[0]);
+        rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION], 2, RL_FLOAT, false, 0, (const void *)(vertex*2*sizeof(float)));
+        rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+        rlEnableVertexBuffer(batch->vboId[1]);
+        rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, false, 0, (const void *)(vertex*2*sizeof(float)));
+        rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+
+        rlEnableVertexBuffer(batch->vboId[2]);
+        rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, true, 0, (const void *)(vertex*sizeof(unsigned int)));
+        rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR]);
+
+        rlDrawVertexArrayElements(0, quads*6, 0);
+    }
+
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableTexture();
+    rlDisableShader();
+}
@@ -0,0 +1,56 @@
+/**********************************************************************************************
+*
+*   Sprite Batch - Many sprites of one texture in one submission
+*
+*   DrawTextureProBatch() is DrawTexturePro() over arrays: one texture, one origin, and
+*   per sprite a destination rectangle, a rotation, an optional source rectangle and an
+*   optional tint. Instead of four rlTexCoord2f()/rlVertex2f() calls and a sinf()/cosf()
+*   pair per sprite, corners are built by one branch-free loop (polynomial sine/cosine,
+*   written to auto-vectorize) into arrays the batch uploads to its own vertex buffers,
+*   then drawn with the default shader, up to 16384 quads per draw call (16 bit indices).
+*   Calls without sources and tints reuse the texture coordinates and colors already
+*   uploaded, only positions are rebuilt.
+*
+*   Draws issued before the call are flushed first, so the usual draw order holds. The
+*   current blend mode and the camera (modelview and projection) apply; rlPushMatrix()
+*   transforms and custom shaders do not, source rectangles are never flipped.
+*
+**********************************************************************************************/
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "raylib.h"
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Destination and rotation of one sprite, same meaning as in DrawTexturePro()
+typedef struct SpriteTransform {
+    float x;
+    float y;
+    float width;
+    float height;
+    float rotationDegrees;
+} SpriteTransform;
+
+typedef struct SpriteBatch {
+    int capacity;                       // Quads the buffers hold, grown on demand
+    int defaultQuads;                   // Leading quads whose uploaded texcoords and colors are whole texture and WHITE
+    std::vector<float> vertices;        // 2 floats per vertex, 4 vertices per quad
+    std::vector<float> texcoords;
+    std::vector<unsigned int> colors;   // RGBA bytes per vertex
+    unsigned int vaoId;                 // 0 when vertex arrays are not supported
+    unsigned int vboId[4];              // Positions, texcoords, colors, indices
+} SpriteBatch;
+
+//----------------------------------------------------------------------------------
+// Sprite Batch Functions Declaration
+//----------------------------------------------------------------------------------
+void InitSpriteBatch(SpriteBatch *batch, int capacity);        // Needs the window, loads the vertex buffers
+void UnloadSpriteBatch(SpriteBatch *batch);
+void DrawTextureProBatch(SpriteBatch *batch, Texture2D texture, const SpriteTransform *transforms, const Rectangle *sources, const Color *tints, int count, Vector2 origin);   // NULL sources: whole texture, NULL tints: WHITE
+
+#endif // SPRITE_BATCH_H
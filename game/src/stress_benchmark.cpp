@@ -0,0 +1,243 @@
+/**********************************************************************************************
+*
+*   Stress Benchmark - Gameplay frame cost against the number of asteroids and particles
+*
+**********************************************************************************************/
+
+#include "stress_benchmark.h"
+#include "raylib.h"
+#include "rlgl.h"                   // Required for: rlDrawRenderBatchActive()
+#include "screens.h"
+#include "particle_system.h"
+#include <stdio.h>
+#include <math.h>                   // Required for: logf()
+#include <vector>
+#include <algorithm>
+
+#define STRESS_WARMUP_FRAMES 10         // Lets pools, caches and the field settle before timing
+#define STRESS_MAX_FRAMES 120
+#define STRESS_MIN_FRAMES 5
+#define STRESS_STEP_SECONDS 3.0         // A count stops early past this, once it has STRESS_MIN_FRAMES
+#define STRESS_SUPERLINEAR_EXPONENT 1.5f
+#define PARTICLE_FRAME_BUDGET_MS (1000.0f/60.0f)
+#define PARTICLE_TARGET_COUNT 100000
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct FrameCost {
+    float mean;                     // Milliseconds
+    float p95;
+} FrameCost;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static const int stressCounts[] = { 100, 300, 1000, 3000, 10000, 30000, 100000, 300000, 1000000 };
+static const int particleCounts[] = { 1000, 10000, 30000, 100000, 200000 };
+
+// Long lived and slow so a steady share of the pool dies and is refilled every frame
+static const ParticleEmitter benchmarkEmitter = { 256, 360.0f, 0.5f, 2.0f, 60.0f, 180.0f, 2.0f, 4.0f, { 255, 160, 60, 255 } };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static FrameCost getFrameCost(std::vector<float> samples)
+{
+    FrameCost cost = { 0 };
+
+    std::sort(samples.begin(), samples.end());
+    for (float sample : samples) cost.mean += sample;
+
+    cost.mean /= samples.size();
+    cost.p95 = samples[(int)(0.95f*(samples.size() - 1) + 0.5f)];
+
+    return cost;
+}
+
+// Slope on a log-log plot: ~1 scales linearly, ~2 is quadratic
+static float getGrowthExponent(float previousCost, float cost, int previousCount, int count)
+{
+    if ((previousCost <= 0.0f) || (cost <= 0.0f)) return 0.0f;
+
+    return logf(cost/previousCost)/logf((float)count/previousCount);
+}
+
+//----------------------------------------------------------------------------------
+// Stress Benchmark Functions Definition
+//----------------------------------------------------------------------------------
+bool RunStressBenchmark(const char *csvFileName)
+{
+    FILE *file = fopen(csvFileName, "w");
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "BENCHMARK: [%s] Could not be created", csvFileName);
+        return false;
+    }
+
+    fprintf(file, "asteroids,frames,update_ms_mean,update_ms_p95,draw_ms_mean,draw_ms_p95\n");
+
+    std::vector<float> updateSamples;
+    std::vector<float> drawSamples;
+    FrameCost previousUpdate = { 0 };
+    FrameCost previousDraw = { 0 };
+    int previousCount = 0;
+    bool isAborted = false;
+
+    SetTargetFPS(0);                // Frames must not wait for the display
+    renderInterpolation = 1.0f;
+
+    for (int count : stressCounts)
+    {
+        stressAsteroidCount = count;
+        InitGameplayScreen();
+
+        updateSamples.clear();
+        drawSamples.clear();
+        double stepStartTime = GetTime();
+
+        for (int frame = 0; frame < STRESS_WARMUP_FRAMES + STRESS_MAX_FRAMES; frame++)
+        {
+            double updateStartTime = GetTime();
+            UpdateGameplayScreen();
+            double updateEndTime = GetTime();
+
+            BeginDrawing();
+            ClearBackground(RAYWHITE);
+
+            double drawStartTime = GetTime();
+            DrawGameplayScreen();
+            rlDrawRenderBatchActive();      // The last partial batch is part of the submission cost
+            double drawEndTime = GetTime();
+
+            EndDrawing();
+
+            if (frame >= STRESS_WARMUP_FRAMES)
+            {
+                updateSamples.push_back((float)((updateEndTime - updateStartTime)*1000.0));
+                drawSamples.push_back((float)((drawEndTime - drawStartTime)*1000.0));
+            }
+
+            if (WindowShouldClose()) { isAborted = true; break; }
+            if (((int)updateSamples.size() >= STRESS_MIN_FRAMES) && (GetTime() - stepStartTime > STRESS_STEP_SECONDS)) break;
+        }
+
+        UnloadGameplayScreen();
+
+        if (isAborted || updateSamples.empty()) break;
+
+        FrameCost update = getFrameCost(updateSamples);
+        FrameCost draw = getFrameCost(drawSamples);
+        float updateExponent = getGrowthExponent(previousUpdate.mean, update.mean, previousCount, count);
+        float drawExponent = getGrowthExponent(previousDraw.mean, draw.mean, previousCount, count);
+
+        TraceLog(LOG_INFO, "BENCHMARK: %7i asteroids, %3i frames, update %8.3f ms (p95 %8.3f, x^%.2f), draw submit %8.3f ms (p95 %8.3f, x^%.2f)",
+                 count, (int)updateSamples.size(), update.mean, update.p95, updateExponent, draw.mean, draw.p95, drawExponent);
+
+        // Small counts are dominated by fixed costs, only large ones can reveal the slope
+        if ((count >= 10000) && (updateExponent > STRESS_SUPERLINEAR_EXPONENT)) TraceLog(LOG_WARNING, "BENCHMARK: Update grows superlinearly at %i asteroids", count);
+        if ((count >= 10000) && (drawExponent > STRESS_SUPERLINEAR_EXPONENT)) TraceLog(LOG_WARNING, "BENCHMARK: Draw submission grows superlinearly at %i asteroids", count);
+
+        fprintf(file, "%i,%i,%.4f,%.4f,%.4f,%.4f\n", count, (int)updateSamples.size(), update.mean, update.p95, draw.mean, draw.p95);
+
+        previousUpdate = update;
+        previousDraw = draw;
+        previousCount = count;
+    }
+
+    fclose(file);
+    stressAsteroidCount = 0;
+
+    if (isAborted) TraceLog(LOG_WARNING, "BENCHMARK: Aborted, [%s] holds the finished counts only", csvFileName);
+    else TraceLog(LOG_INFO, "BENCHMARK: Results written to [%s]", csvFileName);
+
+    return !isAborted;
+}
+
+bool RunParticleBenchmark(const char *csvFileName)
+{
+    FILE *file = fopen(csvFileName, "w");
+    if (file == NULL)
+    {
+        TraceLog(LOG_WARNING, "BENCHMARK: [%s] Could not be created", csvFileName);
+        return false;
+    }
+
+    fprintf(file, "particles,frames,update_ms_mean,update_ms_p95,draw_ms_mean,draw_ms_p95,frame_ms_mean,frame_ms_p95,fits_60fps\n");
+
+    std::vector<float> updateSamples;
+    std::vector<float> drawSamples;
+    std::vector<float> frameSamples;
+    ParticleSystem system;
+    bool isAborted = false;
+
+    SetTargetFPS(0);                // Frames must not wait for the display
+    TraceLog(LOG_INFO, "BENCHMARK: Particle kernel %s, frame budget %.2f ms", GetParticleKernelName(), PARTICLE_FRAME_BUDGET_MS);
+
+    for (int count : particleCounts)
+    {
+        InitParticleSystem(&system, count);
+
+        updateSamples.clear();
+        drawSamples.clear();
+        frameSamples.clear();
+        double stepStartTime = GetTime();
+
+        for (int frame = 0; frame < STRESS_WARMUP_FRAMES + STRESS_MAX_FRAMES; frame++)
+        {
+            double frameStartTime = GetTime();
+
+            // Refilling is part of the update, the pool clamps the last burst
+            while (system.count < count)
+            {
+                Vector2 position = { (float)GetRandomValue(0, GetScreenWidth()), (float)GetRandomValue(0, GetScreenHeight()) };
+                EmitParticles(&system, &benchmarkEmitter, position, 0.0f);
+            }
+
+            UpdateParticles(&system);
+            double updateEndTime = GetTime();
+
+            BeginDrawing();
+            ClearBackground(BLACK);
+
+            double drawStartTime = GetTime();
+            DrawParticles(&system, 1.0f);
+            double drawEndTime = GetTime();
+
+            EndDrawing();
+
+            if (frame >= STRESS_WARMUP_FRAMES)
+            {
+                updateSamples.push_back((float)((updateEndTime - frameStartTime)*1000.0));
+                drawSamples.push_back((float)((drawEndTime - drawStartTime)*1000.0));
+                frameSamples.push_back((float)((GetTime() - frameStartTime)*1000.0));
+            }
+
+            if (WindowShouldClose()) { isAborted = true; break; }
+            if (((int)updateSamples.size() >= STRESS_MIN_FRAMES) && (GetTime() - stepStartTime > STRESS_STEP_SECONDS)) break;
+        }
+
+        UnloadParticleSystem(&system);
+
+        if (isAborted || updateSamples.empty()) break;
+
+        FrameCost update = getFrameCost(updateSamples);
+        FrameCost draw = getFrameCost(drawSamples);
+        FrameCost frame = getFrameCost(frameSamples);
+        bool fitsBudget = (frame.p95 <= PARTICLE_FRAME_BUDGET_MS);
+
+        TraceLog(LOG_INFO, "BENCHMARK: %7i particles, %3i frames, update %7.3f ms (p95 %7.3f), draw submit %7.3f ms (p95 %7.3f), frame %7.3f ms (p95 %7.3f) %s",
+                 count, (int)updateSamples.size(), update.mean, update.p95, draw.mean, draw.p95, frame.mean, frame.p95, fitsBudget? "OK" : "OVER BUDGET");
+
+        if ((count <= PARTICLE_TARGET_COUNT) && !fitsBudget) TraceLog(LOG_WARNING, "BENCHMARK: %i particles do not fit a 60 FPS frame", count);
+
+        fprintf(file, "%i,%i,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%i\n", count, (int)updateSamples.size(), update.mean, update.p95, draw.mean, draw.p95, frame.mean, frame.p95, fitsBudget? 1 : 0);
+    }
+
+    fclose(file);
+
+    if (isAborted) TraceLog(LOG_WARNING, "BENCHMARK: Aborted, [%s] holds the finished counts only", csvFileName);
+    else TraceLog(LOG_INFO, "BENCHMARK: Results written to [%s]", csvFileName);
+
+    return !isAborted;
+}
@@ -0,0 +1,25 @@
+/**********************************************************************************************
+*
+*   Stress Benchmark - Gameplay frame cost against the number of asteroids and particles
+*
+*   Runs the real gameplay screen in stress mode (see SetSimConfigStress()) for asteroid
+*   counts from 100 to 1M and times, per frame, UpdateGameplayScreen() and the CPU side of
+*   DrawGameplayScreen() up to the last batch handed to the GPU. The growth exponent
+*   between two counts flags paths that stopped scaling linearly (collision, removal, draw).
+*
+*   The particle sweep keeps 1k to 200k live particles (bursts refill what dies) and times
+*   UpdateParticles(), DrawParticles() and the whole frame, presented unthrottled; a count
+*   passes when its p95 frame fits the 60 FPS budget. 100k is the target for one core.
+*
+**********************************************************************************************/
+
+#ifndef STRESS_BENCHMARK_H
+#define STRESS_BENCHMARK_H
+
+//----------------------------------------------------------------------------------
+// Stress Benchmark Functions Declaration
+//----------------------------------------------------------------------------------
+bool RunStressBenchmark(const char *csvFileName);      // Needs the window and the global assets, writes one row per count
+bool RunParticleBenchmark(const char *csvFileName);    // Needs the window, writes one row per count
+
+#endif // STRESS_BENCHMARK_H
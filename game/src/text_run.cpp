@@ -0,0 +1,97 @@
+/**********************************************************************************************
+*
+*   Text Run - Single line text kept as prebuilt glyph quads
+*
+**********************************************************************************************/
+
+#include "text_run.h"
+#include "rlgl.h"
+#include <string.h>                 // Required for: strncmp(), memcpy()
+
+//----------------------------------------------------------------------------------
+// Text Run Functions Definition
+//----------------------------------------------------------------------------------
+
+// Glyph placement follows DrawTextEx() and DrawTextCodepoint(), glyph padding included
+bool UpdateTextRun(TextRun *run, Font font, const char *text, float fontSize, float spacing)
+{
+    if (font.texture.id == 0) font = GetFontDefault();
+
+    if ((run->texture.id == font.texture.id) && (run->fontSize == fontSize) && (run->spacing == spacing) &&
+        (strncmp(run->text, text, TEXT_RUN_MAX_LENGTH - 1) == 0)) return false;
+
+    int length = 0;
+    while ((length < TEXT_RUN_MAX_LENGTH - 1) && (text[length] != '\0') && (text[length] != '\n')) length++;
+
+    memcpy(run->text, text, length);
+    run->text[length] = '\0';
+    run->texture = font.texture;
+    run->fontSize = fontSize;
+    run->spacing = spacing;
+    run->glyphCount = 0;
+
+    float scaleFactor = fontSize/font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float textOffsetX = 0.0f;
+
+    for (int i = 0; i < length;)
+    {
+        int codepointByteCount = 0;
+        int codepoint = GetCodepointNext(&run->text[i], &codepointByteCount);
+        int index = GetGlyphIndex(font, codepoint);
+        Rectangle rec = font.recs[index];
+
+        if ((codepoint != ' ') && (codepoint != '\t'))
+        {
+            float left = textOffsetX + (font.glyphs[index].offsetX - padding)*scaleFactor;
+            float top = (font.glyphs[index].offsetY - padding)*scaleFactor;
+            float right = left + (rec.width + 2.0f*padding)*scaleFactor;
+            float bottom = top + (rec.height + 2.0f*padding)*scaleFactor;
+
+            float u0 = (rec.x - padding)/font.texture.width;
+            float v0 = (rec.y - padding)/font.texture.height;
+            float u1 = (rec.x + rec.width + padding)/font.texture.width;
+            float v1 = (rec.y + rec.height + padding)/font.texture.height;
+
+            // Top-left, bottom-left, bottom-right, top-right
+            float *vertex = &run->vertices[run->glyphCount*8];
+            float *texcoord = &run->texcoords[run->glyphCount*8];
+            vertex[0] = left; vertex[1] = top; vertex[2] = left; vertex[3] = bottom;
+            vertex[4] = right; vertex[5] = bottom; vertex[6] = right; vertex[7] = top;
+            texcoord[0] = u0; texcoord[1] = v0; texcoord[2] = u0; texcoord[3] = v1;
+            texcoord[4] = u1; texcoord[5] = v1; texcoord[6] = u1; texcoord[7] = v0;
+
+            run->glyphCount++;
+        }
+
+        if (font.glyphs[index].advanceX == 0) textOffsetX += (rec.width*scaleFactor + spacing);
+        else textOffsetX += ((float)font.glyphs[index].advanceX*scaleFactor + spacing);
+
+        i += codepointByteCount;
+    }
+
+    return true;
+}
+
+// One texture switch for the whole run, quads go into the current render batch
+void DrawTextRun(const TextRun *run, Vector2 position, Color tint)
+{
+    if (run->glyphCount == 0) return;
+
+    rlCheckRenderBatchLimit(run->glyphCount*4);
+
+    rlSetTexture(run->texture.id);
+    rlBegin(RL_QUADS);
+
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        for (int i = 0; i < run->glyphCount*4; i++)
+        {
+            rlTexCoord2f(run->texcoords[i*2], run->texcoords[i*2 + 1]);
+            rlVertex2f(position.x + run->vertices[i*2], position.y + run->vertices[i*2 + 1]);
+        }
+
+    rlEnd();
+    rlSetTexture(0);
+}
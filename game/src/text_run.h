@@ -0,0 +1,44 @@
+/**********************************************************************************************
+*
+*   Text Run - Single line text kept as prebuilt glyph quads
+*
+*   DrawTextEx() decodes the UTF-8 string, looks every glyph up in the font (a linear search)
+*   and works out its rectangles on every call. A TextRun does that once, in UpdateTextRun(),
+*   and keeps the quad corners (relative to the run position) and texture coordinates, so
+*   DrawTextRun() only emits them into the render batch: same quads as DrawTextEx(), same
+*   batch, same draw order. UpdateTextRun() does nothing when text, font, size and spacing
+*   are unchanged, so texts that change rarely (score, timer) can be updated every frame or
+*   only when their value changes.
+*
+*   Single line only, text stops at the first '\n'. Texts longer than TEXT_RUN_MAX_LENGTH
+*   bytes are cut.
+*
+**********************************************************************************************/
+
+#ifndef TEXT_RUN_H
+#define TEXT_RUN_H
+
+#include "raylib.h"
+
+#define TEXT_RUN_MAX_LENGTH 64          // Bytes, terminator included
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct TextRun {
+    char text[TEXT_RUN_MAX_LENGTH];     // Text the quads were built from
+    Texture2D texture;                  // Font atlas, id 0 until first built
+    float fontSize;
+    float spacing;
+    int glyphCount;                     // Spaces and tabs have no quad
+    float vertices[(TEXT_RUN_MAX_LENGTH - 1)*8];    // 4 corners per glyph, same order as DrawTexturePro()
+    float texcoords[(TEXT_RUN_MAX_LENGTH - 1)*8];
+} TextRun;
+
+//----------------------------------------------------------------------------------
+// Text Run Functions Declaration
+//----------------------------------------------------------------------------------
+bool UpdateTextRun(TextRun *run, Font font, const char *text, float fontSize, float spacing);   // True if the quads were rebuilt
+void DrawTextRun(const TextRun *run, Vector2 position, Color tint);
+
+#endif // TEXT_RUN_H
@@ -0,0 +1,61 @@
+/**********************************************************************************************
+*
+*   Tick Input - Key presses delivered per fixed update tick instead of per rendered frame
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+#include "tick_input.h"
+
+#define MAX_TICK_KEYS 512           // Same key range raylib tracks
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static bool pressedKeys[MAX_TICK_KEYS] = { 0 };
+static bool isTapPending = false;
+static bool isInputPending = false;
+
+//----------------------------------------------------------------------------------
+// Tick Input Functions Definition
+//----------------------------------------------------------------------------------
+void PollTickInput(void)
+{
+    // Drains raylib's pressed key queue, pending presses from tickless frames are kept
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed())
+    {
+        if ((key > 0) && (key < MAX_TICK_KEYS))
+        {
+            pressedKeys[key] = true;
+            isInputPending = true;
+        }
+    }
+
+    if (IsGestureDetected(GESTURE_TAP))
+    {
+        isTapPending = true;
+        isInputPending = true;
+    }
+}
+
+void ConsumeTickInput(void)
+{
+    for (int key = 0; key < MAX_TICK_KEYS; key++) pressedKeys[key] = false;
+    isTapPending = false;
+    isInputPending = false;
+}
+
+bool IsKeyPressedTick(int key)
+{
+    return (key > 0) && (key < MAX_TICK_KEYS) && pressedKeys[key];
+}
+
+bool IsTapDetectedTick(void)
+{
+    return isTapPending;
+}
+
+bool HasTickInput(void)
+{
+    return isInputPending;
+}
@@ -0,0 +1,24 @@
+/**********************************************************************************************
+*
+*   Tick Input - Key presses delivered per fixed update tick instead of per rendered frame
+*
+*   Screens update on a fixed 60 Hz tick while frames render at any rate, so one frame can
+*   run zero or several ticks. raylib reports presses per frame: read as-is, a press would
+*   be lost on frames without ticks and repeated on frames with several. Presses gathered
+*   here are handed to exactly one tick, the first one that runs after them.
+*
+**********************************************************************************************/
+
+#ifndef TICK_INPUT_H
+#define TICK_INPUT_H
+
+//----------------------------------------------------------------------------------
+// Tick Input Functions Declaration
+//----------------------------------------------------------------------------------
+void PollTickInput(void);               // Once per rendered frame, before the ticks run
+void ConsumeTickInput(void);            // After each tick, presses are only seen once
+bool IsKeyPressedTick(int key);         // IsKeyPressed() for fixed-step updates
+bool IsTapDetectedTick(void);           // IsGestureDetected(GESTURE_TAP) for fixed-step updates
+bool HasTickInput(void);                // Any press or tap waiting for the next tick
+
+#endif // TICK_INPUT_H
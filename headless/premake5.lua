@@ -0,0 +1,27 @@
+
+baseName = path.getbasename(os.getcwd());
+
+project (baseName)
+    kind "ConsoleApp"
+    location "../_build"
+    targetdir "../_bin/%{cfg.buildcfg}"
+
+    vpaths 
+    {
+        ["Header Files/*"] = { "include/**.h",  "include/**.hpp", "src/**.h", "src/**.hpp", "**.h", "**.hpp"},
+        ["Source Files/*"] = {"src/**.c", "src/**.cpp","**.c", "**.cpp"},
+    }
+    files {"**.c", "**.cpp", "**.h", "**.hpp"}
+  
+    includedirs { "./" }
+    includedirs { "src" }
+    includedirs { "include" }
+    
+    -- Headers only: the simulation core never opens a window or an audio device
+    include_raylib()
+    link_to("simulation")
+
+    -- Shares the game allocation counter to fail runs whose ticks allocate, without the memory tracker behind it
+    files { "../game/src/allocation_counter.cpp", "../game/src/allocation_counter.h" }
+    includedirs { "../game/src" }
+    defines { "COUNT_HEAP_ALLOCATIONS", "DISABLE_MEMORY_TRACKER" }
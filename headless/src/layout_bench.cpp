@@ -0,0 +1,293 @@
+/**********************************************************************************************
+*
+*   Layout Bench - Old array-of-structs entities against the structure-of-arrays store
+*
+*   The old side keeps the structs as they were before the entity store: every asteroid
+*   carries its sprite and the grid is built from bounds gathered out of the structs. The
+*   new side reads AsteroidStore/ShotStore directly.
+*
+*   Both passes are synthetic, written to isolate the data layout:
+*     - move: the per-object trigonometry of the old MoveObjectForwards() runs on both
+*       layouts, so those two columns only differ by layout. The third column is the
+*       MoveAndWrapEntities() kernel StepSimulation() runs on the store, cached velocities
+*       and SIMD included, and is not a layout comparison.
+*     - collide: grid build, AABB queries for every shot and an AABB test of a fixed player
+*       box against every asteroid. It excludes the swept-polygon narrowphase, collision
+*       pairs, hit resolution, splitting and removals of StepSimulation().
+*
+*   The world grows with the entity count so grid cells stay as crowded as in a game.
+*
+**********************************************************************************************/
+
+#include "layout_bench.h"
+#include "entity_store.h"
+#include "movement_kernel.h"
+#include "spatial_grid.h"
+#include "simulation.h"
+#include "prng.h"
+#include <stdio.h>
+#include <math.h>                   // Required for: sqrtf(), cos(), sin()
+#include <vector>
+#include <chrono>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BENCH_CELL_SIZE             64          // Same cell size as the simulation broadphase
+#define BENCH_ASTEROIDS_PER_CELL    4           // World area per asteroid, grid density of a busy game
+#define BENCH_SHOTS_RATIO           100         // One shot per this many asteroids
+#define BENCH_ENTITY_UPDATES        4000000     // Passes repeat until about this many entities were processed
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Entity structs as stored before the entity store
+struct LegacyAsteroid {
+    Texture2D sprite;
+    Vector2 position;
+    Vector2 spriteCenter;
+    float rotationDegrees;
+    float currentSpeed;
+    int size;
+    Rectangle bounds;
+    bool isActive;
+};
+
+struct LegacyShot {
+    Vector2 position;
+    Rectangle bounds;
+    float currentSpeed;
+    float rotationDegrees;
+    int frameslifespan;
+    bool isActive;
+};
+
+typedef struct BenchResult {
+    double moveMs[2];               // Per pass, [0] old layout, [1] new layout, same per-object math
+    double kernelMs;                // Store moved by MoveAndWrapEntities()
+    double collideMs[2];
+    long long hits[2];              // Collision pass results, must match between layouts
+} BenchResult;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static bool checkRecs(Rectangle a, Rectangle b)
+{
+    return (a.x < (b.x + b.width)) && ((a.x + a.width) > b.x) && (a.y < (b.y + b.height)) && ((a.y + a.height) > b.y);
+}
+
+static double getElapsedMs(std::chrono::steady_clock::time_point startTime, int passes)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count()/passes;
+}
+
+// Movement as it was done per object before the entity store, both layouts feed it
+static void moveLegacyObject(float *x, float *y, float rotationDegrees, float speed, Rectangle *bounds, float worldWidth, float worldHeight)
+{
+    *x += speed*cos(rotationDegrees*PI/180);
+    *y += speed*sin(rotationDegrees*PI/180);
+
+    bounds->x = *x;
+    bounds->y = *y;
+
+    if (*x < 0) *x += worldWidth;
+    if (*y < 0) *y += worldHeight;
+    if (*x > worldWidth) *x -= worldWidth;
+    if (*y > worldHeight) *y -= worldHeight;
+}
+
+static long long collideLegacy(SpatialGrid *grid, std::vector<Rectangle> *scratchBounds, std::vector<int> *candidates,
+                               const std::vector<LegacyAsteroid> &asteroids, const std::vector<LegacyShot> &shots, Rectangle playerBounds)
+{
+    long long hits = 0;
+
+    scratchBounds->clear();
+    for (const LegacyAsteroid &asteroid : asteroids) scratchBounds->push_back(asteroid.bounds);
+
+    BuildSpatialGrid(grid, scratchBounds->data(), (int)scratchBounds->size());
+
+    for (const LegacyShot &shot : shots)
+    {
+        QuerySpatialGrid(grid, shot.bounds, candidates);
+
+        for (int index : *candidates)
+        {
+            if (checkRecs(asteroids[index].bounds, shot.bounds) && asteroids[index].isActive && shot.isActive) hits++;
+        }
+    }
+
+    for (const LegacyAsteroid &asteroid : asteroids)
+    {
+        if (checkRecs(asteroid.bounds, playerBounds)) hits++;
+    }
+
+    return hits;
+}
+
+static long long collideStore(SpatialGrid *grid, std::vector<int> *candidates, const AsteroidStore &asteroids, const ShotStore &shots, Rectangle playerBounds)
+{
+    long long hits = 0;
+
+    BuildSpatialGrid(grid, asteroids.bounds.data(), GetAsteroidCount(asteroids));
+
+    for (int shot = 0; shot < GetShotCount(shots); shot++)
+    {
+        QuerySpatialGrid(grid, shots.bounds[shot], candidates);
+
+        for (int index : *candidates)
+        {
+            if (checkRecs(asteroids.bounds[index], shots.bounds[shot]) && asteroids.isActive[index] && shots.isActive[shot]) hits++;
+        }
+    }
+
+    for (int asteroid = 0; asteroid < GetAsteroidCount(asteroids); asteroid++)
+    {
+        if (checkRecs(asteroids.bounds[asteroid], playerBounds)) hits++;
+    }
+
+    return hits;
+}
+
+// Spawns the same random entities in both layouts and times their passes
+static BenchResult runLayoutBench(int asteroidCount)
+{
+    BenchResult result = { };
+    SimConfig config = GetDefaultSimConfig();
+
+    float worldSize = BENCH_CELL_SIZE*sqrtf((float)asteroidCount/BENCH_ASTEROIDS_PER_CELL);
+    int shotCount = asteroidCount/BENCH_SHOTS_RATIO;
+    int passes = (BENCH_ENTITY_UPDATES/asteroidCount > 4)? BENCH_ENTITY_UPDATES/asteroidCount : 4;
+    Rectangle playerBounds = { worldSize/2, worldSize/2, config.playerSize.x, config.playerSize.y };
+
+    std::vector<LegacyAsteroid> legacyAsteroids(asteroidCount);
+    std::vector<LegacyShot> legacyShots(shotCount);
+    AsteroidStore asteroids;
+    ShotStore shots;
+    InitAsteroids(&asteroids, asteroidCount);
+    InitShots(&shots, shotCount);
+
+    Prng rng;
+    SeedPrng(&rng, 1);
+
+    for (int i = 0; i < asteroidCount; i++)
+    {
+        Vector2 position = { (float)GetPrngBounded(&rng, (int)worldSize), (float)GetPrngBounded(&rng, (int)worldSize) };
+        float rotationDegrees = (float)GetPrngBounded(&rng, 360);
+        int size = 1 + GetPrngBounded(&rng, 3);
+        Vector2 spriteSize = config.asteroidSizes[size];
+
+        LegacyAsteroid &asteroid = legacyAsteroids[i];
+        asteroid.sprite = { 0 };
+        asteroid.sprite.width = (int)spriteSize.x;
+        asteroid.sprite.height = (int)spriteSize.y;
+        asteroid.position = position;
+        asteroid.spriteCenter = { spriteSize.x/2, spriteSize.y/2 };
+        asteroid.rotationDegrees = rotationDegrees;
+        asteroid.currentSpeed = config.asteroidSpeed;
+        asteroid.size = size;
+        asteroid.bounds = { position.x, position.y, spriteSize.x, spriteSize.y };
+        asteroid.isActive = true;
+
+        SpawnAsteroid(&asteroids, position, rotationDegrees, GetHeadingVector(rotationDegrees, config.asteroidSpeed), size, spriteSize.x, spriteSize.y);
+    }
+
+    for (int i = 0; i < shotCount; i++)
+    {
+        Vector2 position = { (float)GetPrngBounded(&rng, (int)worldSize), (float)GetPrngBounded(&rng, (int)worldSize) };
+        float rotationDegrees = (float)GetPrngBounded(&rng, 360);
+
+        LegacyShot &shot = legacyShots[i];
+        shot.position = position;
+        shot.bounds = { position.x, position.y, config.shotSize, config.shotSize };
+        shot.currentSpeed = config.shotSpeed;
+        shot.rotationDegrees = rotationDegrees;
+        shot.frameslifespan = config.shotFramesLifespan;
+        shot.isActive = true;
+
+        SpawnShot(&shots, position, rotationDegrees, GetHeadingVector(rotationDegrees, config.shotSpeed), config.shotSize, config.shotFramesLifespan);
+    }
+
+    CommitPendingAsteroids(&asteroids);
+    CommitPendingShots(&shots);
+
+    //Scratch memory is sized up front, passes do not allocate
+    SpatialGrid grids[2];
+    std::vector<Rectangle> scratchBounds;
+    std::vector<int> candidates;
+    InitSpatialGrid(&grids[0], worldSize, worldSize, BENCH_CELL_SIZE, asteroidCount);
+    InitSpatialGrid(&grids[1], worldSize, worldSize, BENCH_CELL_SIZE, asteroidCount);
+    scratchBounds.reserve(asteroidCount);
+    candidates.reserve(asteroidCount);
+
+    //The kernel moves its own copy, the layout-only passes start from the same positions
+    AsteroidStore kernelAsteroids = asteroids;
+
+    //Collisions first, both layouts still hold identical positions
+    auto startTime = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) result.hits[0] = collideLegacy(&grids[0], &scratchBounds, &candidates, legacyAsteroids, legacyShots, playerBounds);
+    result.collideMs[0] = getElapsedMs(startTime, passes);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++) result.hits[1] = collideStore(&grids[1], &candidates, asteroids, shots, playerBounds);
+    result.collideMs[1] = getElapsedMs(startTime, passes);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (LegacyAsteroid &asteroid : legacyAsteroids)
+        {
+            moveLegacyObject(&asteroid.position.x, &asteroid.position.y, asteroid.rotationDegrees, asteroid.currentSpeed, &asteroid.bounds, worldSize, worldSize);
+        }
+    }
+    result.moveMs[0] = getElapsedMs(startTime, passes);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (int i = 0; i < GetAsteroidCount(asteroids); i++)
+        {
+            moveLegacyObject(&asteroids.positionX[i], &asteroids.positionY[i], asteroids.rotationDegrees[i], config.asteroidSpeed, &asteroids.bounds[i], worldSize, worldSize);
+        }
+    }
+    result.moveMs[1] = getElapsedMs(startTime, passes);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        MoveAndWrapEntities(kernelAsteroids.positionX.data(), kernelAsteroids.positionY.data(), kernelAsteroids.velocityX.data(), kernelAsteroids.velocityY.data(),
+                            kernelAsteroids.bounds.data(), GetAsteroidCount(kernelAsteroids), worldSize, worldSize);
+    }
+    result.kernelMs = getElapsedMs(startTime, passes);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+int RunLayoutBenchmark(void)
+{
+    const int entityCounts[] = { 10000, 100000, 1000000 };
+    int result = 0;
+
+    printf("HEADLESS: Layout bench, old AoS structs against the SoA store, synthetic passes\n");
+    printf("HEADLESS:   move     per-object trig on both layouts, kernel is MoveAndWrapEntities() (%s) on the store\n", GetMovementKernelName());
+    printf("HEADLESS:   collide  grid build + AABB shot queries + AABB player test, no swept-polygon narrowphase or hit handling\n");
+    printf("HEADLESS: %10s %12s %12s %12s %12s %12s   (ms per pass)\n", "asteroids", "move AoS", "move SoA", "move kernel", "collide AoS", "collide SoA");
+
+    for (int count : entityCounts)
+    {
+        BenchResult bench = runLayoutBench(count);
+
+        printf("HEADLESS: %10i %12.3f %12.3f %12.3f %12.3f %12.3f\n", count, bench.moveMs[0], bench.moveMs[1], bench.kernelMs, bench.collideMs[0], bench.collideMs[1]);
+
+        if (bench.hits[0] != bench.hits[1])
+        {
+            fprintf(stderr, "HEADLESS: Layouts disagree at %i asteroids (%lld hits AoS, %lld hits SoA)\n", count, bench.hits[0], bench.hits[1]);
+            result = 1;
+        }
+    }
+
+    return result;
+}
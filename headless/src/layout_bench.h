@@ -0,0 +1,20 @@
+/**********************************************************************************************
+*
+*   Layout Bench - Old array-of-structs entities against the structure-of-arrays store
+*
+*   Times a synthetic asteroid movement pass and a synthetic shot/asteroid broadphase pass
+*   (grid build, AABB shot queries, AABB player test against every asteroid) at 10k, 100k
+*   and 1M entities, once on the original fat Asteroid/PlayerShot structs and once on
+*   AsteroidStore/ShotStore. Neither is StepSimulation(), see layout_bench.cpp.
+*
+**********************************************************************************************/
+
+#ifndef LAYOUT_BENCH_H
+#define LAYOUT_BENCH_H
+
+//----------------------------------------------------------------------------------
+// Layout Bench Functions Declaration
+//----------------------------------------------------------------------------------
+int RunLayoutBenchmark(void);       // Prints one line per entity count, returns non-zero if both layouts disagree
+
+#endif // LAYOUT_BENCH_H
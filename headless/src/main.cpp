@@ -0,0 +1,282 @@
+/**********************************************************************************************
+*
+*   Headless - Runs the ASTEROIDS simulation core without window or audio
+*
+*   Plays games back to back with a simple autopilot (turn, thrust and shoot on a fixed
+*   pattern), checks pool and world invariants every tick and reports ticks per second.
+*   Past a short warmup, any tick that reaches the heap fails the run (allocation_counter.h).
+*   The first game can be recorded, and recorded sessions (from here or from the game)
+*   can be replayed as fixed workloads, checking the state hash of every tick.
+*   --stress N runs the stress mode (N asteroids, auto-fire) to soak the pools at scale.
+*   --verify-broadphase sweeps a set of seeds (normal and stress games) checking every
+*   broadphase query against brute force, fails on the first tick with a missed pair.
+*   --layout-bench times synthetic movement and broadphase passes on the old array-of-structs
+*   entities and on the entity store, at 10k, 100k and 1M asteroids.
+*
+*   Usage: headless [--ticks N] [--seed N] [--stress N] [--record FILE]
+*          headless --replay FILE
+*          headless --verify-broadphase [--ticks N] [--seed N]
+*          headless --layout-bench
+*
+**********************************************************************************************/
+
+#include "simulation.h"
+#include "replay.h"
+#include "profiler.h"
+#include "autopilot.h"
+#include "layout_bench.h"
+#include "allocation_counter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ALLOCATION_WARMUP_TICKS     600         // Ticks before the soak requires allocation-free steps
+#define VERIFY_SEED_COUNT           16          // Seeds swept per configuration by --verify-broadphase
+#define VERIFY_TICKS_PER_SEED       3600        // One minute of game per seed, unless --ticks is given
+#define VERIFY_STRESS_ASTEROIDS     500         // Stress configuration swept after the normal one
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static bool checkInvariants(const GameState *state)
+{
+    const AsteroidStore &asteroids = state->asteroids;
+    const ShotStore &shots = state->shots;
+
+    if (GetAsteroidCount(asteroids) > state->config.asteroidCapacity) return false;
+    if (GetShotCount(shots) > state->config.shotCapacity) return false;
+
+    for (int i = 0; i < GetAsteroidCount(asteroids); i++)
+    {
+        if (!asteroids.isActive[i]) return false;
+        if ((asteroids.positionX[i] < 0.0f) || (asteroids.positionX[i] > state->config.worldWidth)) return false;
+        if ((asteroids.positionY[i] < 0.0f) || (asteroids.positionY[i] > state->config.worldHeight)) return false;
+    }
+
+    for (int i = 0; i < GetShotCount(shots); i++)
+    {
+        if (!shots.isActive[i] || (shots.framesLifespan[i] <= 0)) return false;
+    }
+
+    return (state->player.lives >= 0);
+}
+
+#if defined(ENABLE_PROFILER)
+// Per-phase percentiles over the last ticks still in the profiler ring
+static void printProfileSummary(void)
+{
+    ProfileStats stats[PROFILER_MAX_PHASES];
+    int count = GetProfileStats(stats, PROFILER_MAX_PHASES, 1000);
+
+    printf("HEADLESS: %-26s %8s %8s %8s %8s\n", "phase (us)", "p50", "p95", "p99", "max");
+    for (int i = 0; i < count; i++) printf("HEADLESS: %-26s %8.2f %8.2f %8.2f %8.2f\n", stats[i].name, stats[i].p50, stats[i].p95, stats[i].p99, stats[i].max);
+}
+#endif
+
+// Plays autopilot games back to back for the given number of ticks
+static int runSoak(long long ticks, uint64_t seed, const SimConfig &config, const char *recordFileName)
+{
+    GameState state;
+    Autopilot pilot;
+    InitSimulation(&state, &config, seed);
+    InitAutopilot(&pilot, AUTOPILOT_SCRIPTED, seed);
+
+    ReplayWriter writer = { 0 };
+    if ((recordFileName != NULL) && !OpenReplayWriter(&writer, recordFileName, seed, &config))
+    {
+        fprintf(stderr, "HEADLESS: Could not create replay file %s\n", recordFileName);
+        return 1;
+    }
+
+    int games = 1;
+    long long bestScore = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (long long tick = 0; tick < ticks; tick++)
+    {
+        PROFILE_FRAME_MARK();
+
+        SimInput input = GetAutopilotInput(&pilot, &state);
+
+        unsigned long long allocationsBeforeStep = GetHeapAllocationCount();
+        StepSimulation(&state, input);
+
+        //Pools and scratch buffers are sized at init, a step at steady state must never reach the heap
+        unsigned long long stepAllocations = GetHeapAllocationCount() - allocationsBeforeStep;
+        if ((tick >= ALLOCATION_WARMUP_TICKS) && (stepAllocations > 0))
+        {
+            fprintf(stderr, "HEADLESS: Tick %lld made %llu heap allocations (game %i, frame %i)\n", tick, stepAllocations, games, state.framesCounter);
+            return 1;
+        }
+
+        if (!checkInvariants(&state))
+        {
+            fprintf(stderr, "HEADLESS: Invariant broken at tick %lld (game %i, frame %i)\n", tick, games, state.framesCounter);
+            return 1;
+        }
+
+        //Only the first game is recorded, a replay holds a single game
+        if (writer.file != NULL) WriteReplayFrame(&writer, input, GetSimulationHash(&state));
+
+        if (state.isFinished)
+        {
+            if (state.player.score > bestScore) bestScore = state.player.score;
+            CloseReplayWriter(&writer);
+
+            //Every game gets its own reproducible seed
+            InitSimulation(&state, &config, seed + games);
+            games++;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    printf("HEADLESS: %lld ticks, %i games, best score %lld\n", ticks, games, bestScore);
+    if (config.stressAsteroidCount > 0) printf("HEADLESS: Stress mode, %i asteroids target, %i alive at the end\n", config.stressAsteroidCount, GetAsteroidCount(state.asteroids));
+    printf("HEADLESS: %.3f s, %.0f ticks/s (%.1fx real time)\n", seconds, ticks/seconds, ticks/seconds/SIM_TICKS_PER_SECOND);
+
+#if defined(ENABLE_PROFILER)
+    printProfileSummary();
+#endif
+
+    CloseReplayWriter(&writer);
+    UnloadSimulation(&state);
+
+    return 0;
+}
+
+// Steps autopilot games on a sweep of seeds with the broadphase cross-check enabled
+static int runVerifyBroadphase(long long ticksPerSeed, uint64_t firstSeed)
+{
+    SimConfig configs[2] = { GetDefaultSimConfig(), GetDefaultSimConfig() };
+    SetSimConfigStress(&configs[1], VERIFY_STRESS_ASTEROIDS);
+
+    long long totalTicks = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < 2; c++)
+    {
+        for (uint64_t seed = firstSeed; seed < firstSeed + VERIFY_SEED_COUNT; seed++)
+        {
+            GameState state;
+            Autopilot pilot;
+            InitSimulation(&state, &configs[c], seed);
+            InitAutopilot(&pilot, AUTOPILOT_SCRIPTED, seed);
+            state.isVerifyingBroadphase = true;
+
+            for (long long tick = 0; tick < ticksPerSeed; tick++)
+            {
+                StepSimulation(&state, GetAutopilotInput(&pilot, &state));
+                totalTicks++;
+
+                if (state.broadphaseMisses > 0)
+                {
+                    fprintf(stderr, "HEADLESS: Broadphase missed %lld pairs at tick %lld (seed %llu, %s)\n", state.broadphaseMisses, tick,
+                        (unsigned long long)seed, (configs[c].stressAsteroidCount > 0)? "stress" : "normal");
+                    UnloadSimulation(&state);
+                    return 1;
+                }
+
+                //Keep the pools populated, a finished game restarts on the same seed
+                if (state.isFinished)
+                {
+                    InitSimulation(&state, &configs[c], seed);
+                    state.isVerifyingBroadphase = true;
+                }
+            }
+
+            UnloadSimulation(&state);
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    printf("HEADLESS: Broadphase verified on %i seeds x 2 configurations, %lld ticks, no missed pairs\n", VERIFY_SEED_COUNT, totalTicks);
+    printf("HEADLESS: %.3f s\n", seconds);
+
+    return 0;
+}
+
+// Replays a recorded session, stops at the first tick whose state hash differs
+static int runReplay(const char *fileName)
+{
+    ReplayReader reader = { 0 };
+    if (!OpenReplayReader(&reader, fileName))
+    {
+        fprintf(stderr, "HEADLESS: %s is not a valid replay file\n", fileName);
+        return 1;
+    }
+
+    GameState state;
+    InitSimulation(&state, &reader.config, reader.seed);
+
+    SimInput input = { 0 };
+    uint32_t recordedHash = 0;
+    int result = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (ReadReplayFrame(&reader, &input, &recordedHash))
+    {
+        StepSimulation(&state, input);
+
+        uint32_t stateHash = GetSimulationHash(&state);
+        if (stateHash != recordedHash)
+        {
+            fprintf(stderr, "HEADLESS: Desync at frame %i (recorded %08x, replayed %08x)\n", reader.frames, recordedHash, stateHash);
+            result = 1;
+            break;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    printf("HEADLESS: Replayed %i frames of %s, score %i, %s\n", reader.frames, fileName, state.player.score, (result == 0)? "in sync" : "DESYNC");
+    printf("HEADLESS: %.3f s, %.3f us/tick\n", seconds, seconds*1000000.0/((reader.frames > 0)? reader.frames : 1));
+
+    CloseReplayReader(&reader);
+    UnloadSimulation(&state);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    long long ticks = 0;
+    uint64_t seed = 1;
+    bool verifyBroadphase = false;
+    bool layoutBench = false;
+    const char *recordFileName = NULL;
+    const char *replayFileName = NULL;
+    SimConfig config = GetDefaultSimConfig();
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--ticks") == 0) && (i + 1 < argc)) ticks = atoll(argv[++i]);
+        else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc)) seed = strtoull(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "--stress") == 0) && (i + 1 < argc)) SetSimConfigStress(&config, atoi(argv[++i]));
+        else if ((strcmp(argv[i], "--record") == 0) && (i + 1 < argc)) recordFileName = argv[++i];
+        else if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc)) replayFileName = argv[++i];
+        else if (strcmp(argv[i], "--verify-broadphase") == 0) verifyBroadphase = true;
+        else if (strcmp(argv[i], "--layout-bench") == 0) layoutBench = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--ticks N] [--seed N] [--stress N] [--record FILE] | --replay FILE | --verify-broadphase | --layout-bench\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (replayFileName != NULL) return runReplay(replayFileName);
+    if (layoutBench) return RunLayoutBenchmark();
+    if (verifyBroadphase) return runVerifyBroadphase((ticks > 0)? ticks : VERIFY_TICKS_PER_SEED, seed);
+
+    return runSoak((ticks > 0)? ticks : 1000000, seed, config, recordFileName);
+}
@@ -13,6 +13,18 @@ newoption
     default = "opengl33"
 }
 
+newoption
+{
+    trigger = "profiler",
+    description = "compile the frame profiler into release builds (always on in debug)"
+}
+
+newoption
+{
+    trigger = "memory",
+    description = "compile per-subsystem heap tracking into release builds (always on in debug)"
+}
+
 function string.starts(String,Start)
     return string.sub(String,1,string.len(Start))==Start
 end
@@ -67,6 +79,12 @@ workspace (workspaceName)
         defines { "NDEBUG" }
         optimize "On"
 
+    filter { "options:profiler" }
+        defines { "ENABLE_PROFILER" }
+
+    filter { "options:memory" }
+        defines { "TRACK_MEMORY" }
+
     filter { "platforms:x64" }
         architecture "x86_64"
 		
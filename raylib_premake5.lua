@@ -107,6 +107,11 @@ project "raylib"
         ["Source Files/*"] = { raylib_dir .. "/src/**.c"},
     }
     files {raylib_dir .. "/src/*.h", raylib_dir .. "/src/*.c"}
+
+    -- Routes RL_MALLOC and friends to the game memory tracker, the header is empty unless TRACK_MEMORY is on
+    if (os.isfile("game/src/memory_hooks.h")) then
+        forceincludes { "game/src/memory_hooks.h" }
+    end
     filter { "system:macosx", "files:" .. raylib_dir .. "/src/rglfw.c" }
         compileas "Objective-C"
 
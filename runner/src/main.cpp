@@ -0,0 +1,261 @@
+/**********************************************************************************************
+*
+*   Runner - Plays thousands of ASTEROIDS games in parallel for balancing and soak tests
+*
+*   Every game is independent (own GameState, own seed, own autopilot), so games are spread
+*   over a work-stealing pool with nothing shared but the results table, one slot per game.
+*   Reports the score and survival time distributions (the values the gameplay screen
+*   saves as high scores) and simulated ticks per second per worker and overall.
+*
+*   Tunables can be overridden with --set, e.g. --set asteroidSpeed=3 --set powerUpGenerationRate=300
+*   --leaderboard appends every game to a leaderboard (BASE.runs, BASE.index) in one batch,
+*   the way attract-mode kiosks fill it, to check ranking at millions of runs.
+*
+*   Usage: runner [--games N] [--threads N] [--seed N] [--autopilot scripted|random]
+*                 [--max-seconds N] [--set name=value]... [--csv FILE] [--leaderboard BASE]
+*
+**********************************************************************************************/
+
+#include "simulation.h"
+#include "autopilot.h"
+#include "work_stealing_pool.h"
+#include "leaderboard.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct GameResult {
+    int score;                      // Same values as the gameplay screen saves to the leaderboard
+    int survivalSeconds;
+    int ticks;
+} GameResult;
+
+// Worker results, padded so the hot tick counters of two workers never share a line
+typedef struct alignas(64) WorkerTicks {
+    long long ticks;
+} WorkerTicks;
+
+// --set name=value target
+typedef struct ConfigTunable {
+    const char *name;
+    float *floatValue;
+    int *intValue;
+} ConfigTunable;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static bool setConfigTunable(SimConfig *config, const char *assignment)
+{
+    const ConfigTunable tunables[] = {
+        { "asteroidSpeed", &config->asteroidSpeed, NULL },
+        { "shotSpeed", &config->shotSpeed, NULL },
+        { "shotSize", &config->shotSize, NULL },
+        { "shotFramesLifespan", NULL, &config->shotFramesLifespan },
+        { "playerShotCooldownFrames", NULL, &config->playerShotCooldownFrames },
+        { "playerInvencibilityFrames", NULL, &config->playerInvencibilityFrames },
+        { "playerPowerUpLifespan", NULL, &config->playerPowerUpLifespan },
+        { "powerUpFramesLifespan", NULL, &config->powerUpFramesLifespan },
+        { "powerUpGenerationRate", NULL, &config->powerUpGenerationRate },
+        { "powerUpShotCount", NULL, &config->powerUpShotCount },
+        { "multipleShotDeviationDegrees", NULL, &config->multipleShotDeviationDegrees },
+    };
+
+    const char *value = strchr(assignment, '=');
+    if (value == NULL) return false;
+
+    int nameLength = (int)(value - assignment);
+    value++;
+
+    for (const ConfigTunable &tunable : tunables)
+    {
+        if (((int)strlen(tunable.name) != nameLength) || (strncmp(tunable.name, assignment, nameLength) != 0)) continue;
+
+        if (tunable.floatValue != NULL) *tunable.floatValue = (float)atof(value);
+        else *tunable.intValue = atoi(value);
+
+        return true;
+    }
+
+    return false;
+}
+
+// Prints mean, min, p10/p50/p90/p99 and max of one result column
+static void printDistribution(const char *label, std::vector<int> values)
+{
+    if (values.empty()) return;
+
+    std::sort(values.begin(), values.end());
+
+    double sum = 0.0;
+    for (int value : values) sum += value;
+
+    int count = (int)values.size();
+    auto percentile = [&](float p) { return values[(int)(p*(count - 1) + 0.5f)]; };
+
+    printf("RUNNER: %-16s mean %9.1f  min %6i  p10 %6i  p50 %6i  p90 %6i  p99 %6i  max %6i\n", label,
+           sum/count, values[0], percentile(0.10f), percentile(0.50f), percentile(0.90f), percentile(0.99f), values[count - 1]);
+}
+
+static bool writeResultsCsv(const char *fileName, uint64_t seed, const std::vector<GameResult> &results)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "game,seed,score,survival_seconds,ticks\n");
+    for (int game = 0; game < (int)results.size(); game++)
+    {
+        fprintf(file, "%i,%llu,%i,%i,%i\n", game, (unsigned long long)(seed + game), results[game].score, results[game].survivalSeconds, results[game].ticks);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+static bool appendLeaderboard(const char *baseFileName, uint64_t seed, const std::vector<GameResult> &results)
+{
+    Leaderboard board;
+    if (!OpenLeaderboard(&board, baseFileName)) return false;
+
+    int64_t date = (int64_t)time(NULL);
+    std::vector<LeaderboardRun> runs(results.size());
+
+    for (int game = 0; game < (int)results.size(); game++)
+    {
+        runs[game] = { results[game].score, (unsigned int)results[game].ticks, seed + game, date, 0 };
+    }
+
+    if (!AppendLeaderboardRuns(&board, runs.data(), (int)runs.size())) return false;
+
+    printf("RUNNER: %llu runs in %s, best score %i\n", (unsigned long long)board.top.runCount, board.runsFileName, (board.top.count > 0)? board.top.entries[0].score : 0);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int games = 10000;
+    int threads = (int)std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+    AutopilotMode pilotMode = AUTOPILOT_SCRIPTED;
+    int maxSeconds = 600;           // Games the autopilot never loses are cut here
+    const char *csvFileName = NULL;
+    const char *leaderboardBaseName = NULL;
+    SimConfig config = GetDefaultSimConfig();
+
+    const char *usage = "Usage: %s [--games N] [--threads N] [--seed N] [--autopilot scripted|random] [--max-seconds N] [--set name=value]... [--csv FILE] [--leaderboard BASE]\n";
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--games") == 0) && (i + 1 < argc)) games = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) threads = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc)) seed = strtoull(argv[++i], NULL, 10);
+        else if ((strcmp(argv[i], "--autopilot") == 0) && (i + 1 < argc)) pilotMode = (strcmp(argv[++i], "random") == 0)? AUTOPILOT_RANDOM : AUTOPILOT_SCRIPTED;
+        else if ((strcmp(argv[i], "--max-seconds") == 0) && (i + 1 < argc)) maxSeconds = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--csv") == 0) && (i + 1 < argc)) csvFileName = argv[++i];
+        else if ((strcmp(argv[i], "--leaderboard") == 0) && (i + 1 < argc)) leaderboardBaseName = argv[++i];
+        else if ((strcmp(argv[i], "--set") == 0) && (i + 1 < argc) && setConfigTunable(&config, argv[i + 1])) i++;
+        else
+        {
+            fprintf(stderr, usage, argv[0]);
+            return 1;
+        }
+    }
+
+    if (!IsSimConfigValid(&config))
+    {
+        fprintf(stderr, "RUNNER: --set value out of range (powerUpGenerationRate >= 1, speeds and shotSize > 0, other counts and lifespans >= 0)\n");
+        fprintf(stderr, usage, argv[0]);
+        return 1;
+    }
+
+    if (threads < 1) threads = 1;
+    if (games < 1) games = 1;
+
+    int maxTicks = maxSeconds*SIM_TICKS_PER_SECOND;
+
+    std::vector<GameResult> results(games);
+    std::vector<WorkerStats> workerStats(threads);
+    std::vector<WorkerTicks> workerTicks(threads);
+
+    // One GameState per worker, InitSimulation() reuses its pools from game to game
+    std::vector<GameState> states(threads);
+    for (int i = 0; i < threads; i++) InitSimulation(&states[i], &config, seed);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    RunWorkStealing(games, threads, [&](int game, int worker)
+    {
+        GameState *state = &states[worker];
+        Autopilot pilot;
+
+        InitSimulation(state, &config, seed + game);
+        InitAutopilot(&pilot, pilotMode, seed + game);
+
+        while (!state->isFinished && (state->framesCounter < maxTicks)) StepSimulation(state, GetAutopilotInput(&pilot, state));
+
+        results[game].score = state->player.score;
+        results[game].survivalSeconds = (int)GetSimulationTime(state);
+        results[game].ticks = state->framesCounter;
+        workerTicks[worker].ticks += state->framesCounter;
+    }, workerStats.data());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    for (GameState &state : states) UnloadSimulation(&state);
+
+    // Report
+    //----------------------------------------------------------------------------------
+    std::vector<int> scores(games);
+    std::vector<int> survivalSeconds(games);
+    long long totalTicks = 0;
+    int cutGames = 0;
+
+    for (int game = 0; game < games; game++)
+    {
+        scores[game] = results[game].score;
+        survivalSeconds[game] = results[game].survivalSeconds;
+        totalTicks += results[game].ticks;
+        if (results[game].ticks >= maxTicks) cutGames++;
+    }
+
+    printf("RUNNER: %i games (%s autopilot, seeds %llu..%llu), %i cut at %i s\n", games, (pilotMode == AUTOPILOT_RANDOM)? "random" : "scripted",
+           (unsigned long long)seed, (unsigned long long)(seed + games - 1), cutGames, maxSeconds);
+    printDistribution("score", scores);
+    printDistribution("survival (s)", survivalSeconds);
+
+    for (int i = 0; i < threads; i++)
+    {
+        double busySeconds = (workerStats[i].busySeconds > 0.0)? workerStats[i].busySeconds : 1.0;
+        printf("RUNNER: worker %3i  %6i games (%5i stolen)  %12lld ticks  %10.0f ticks/s\n", i, workerStats[i].tasksRun, workerStats[i].tasksStolen,
+               workerTicks[i].ticks, workerTicks[i].ticks/busySeconds);
+    }
+
+    printf("RUNNER: %.3f s on %i threads, %.0f ticks/s total, %.0f ticks/s per thread\n", seconds, threads, totalTicks/seconds, totalTicks/seconds/threads);
+
+    if ((csvFileName != NULL) && !writeResultsCsv(csvFileName, seed, results))
+    {
+        fprintf(stderr, "RUNNER: Could not write %s\n", csvFileName);
+        return 1;
+    }
+
+    if ((leaderboardBaseName != NULL) && !appendLeaderboard(leaderboardBaseName, seed, results))
+    {
+        fprintf(stderr, "RUNNER: Could not append to leaderboard %s\n", leaderboardBaseName);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**********************************************************************************************
+*
+*   Work Stealing Pool - Runs task indices [0, count) across threads
+*
+**********************************************************************************************/
+
+#include "work_stealing_pool.h"
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// One cache line per worker so owners popping never contend with their neighbours
+typedef struct alignas(64) WorkerSlice {
+    std::atomic<uint64_t> range;    // begin in the low 32 bits, end in the high 32 bits
+} WorkerSlice;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static uint64_t packRange(uint32_t begin, uint32_t end)
+{
+    return ((uint64_t)end << 32) | begin;
+}
+
+// Owner side: takes the first index of the slice, -1 when empty
+static int popFront(WorkerSlice *slice)
+{
+    uint64_t range = slice->range.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        uint32_t begin = (uint32_t)range;
+        uint32_t end = (uint32_t)(range >> 32);
+        if (begin >= end) return -1;
+
+        if (slice->range.compare_exchange_weak(range, packRange(begin + 1, end), std::memory_order_acq_rel)) return (int)begin;
+    }
+}
+
+// Thief side: moves the back half of the victim slice into the thief's empty slice, returns one index to run now
+static int stealHalf(WorkerSlice *victim, WorkerSlice *thief)
+{
+    uint64_t range = victim->range.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        uint32_t begin = (uint32_t)range;
+        uint32_t end = (uint32_t)(range >> 32);
+        if (begin >= end) return -1;
+
+        uint32_t middle = begin + (end - begin)/2;
+
+        if (victim->range.compare_exchange_weak(range, packRange(begin, middle), std::memory_order_acq_rel))
+        {
+            thief->range.store(packRange(middle + 1, end), std::memory_order_release);
+            return (int)middle;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Work Stealing Pool Functions Definition
+//----------------------------------------------------------------------------------
+void RunWorkStealing(int taskCount, int threadCount, const std::function<void(int task, int worker)> &task, WorkerStats *stats)
+{
+    std::vector<WorkerSlice> slices(threadCount);
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        uint32_t begin = (uint32_t)((long long)taskCount*i/threadCount);
+        uint32_t end = (uint32_t)((long long)taskCount*(i + 1)/threadCount);
+        slices[i].range.store(packRange(begin, end));
+        stats[i] = WorkerStats{ 0 };
+    }
+
+    auto worker = [&](int self)
+    {
+        WorkerStats &workerStats = stats[self];
+
+        while (true)
+        {
+            int index = popFront(&slices[self]);
+            bool isStolen = false;
+
+            // Scan the other workers once, starting next to us so thieves spread out
+            for (int offset = 1; (index == -1) && (offset < threadCount); offset++)
+            {
+                index = stealHalf(&slices[(self + offset)%threadCount], &slices[self]);
+                isStolen = (index != -1);
+            }
+
+            // Every slice was empty: remaining tasks are already owned by running workers
+            if (index == -1) break;
+
+            auto startTime = std::chrono::steady_clock::now();
+            task(index, self);
+            workerStats.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+            workerStats.tasksRun++;
+            if (isStolen) workerStats.tasksStolen += 1;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; i++) threads.emplace_back(worker, i);
+
+    worker(0);      // The calling thread works too
+
+    for (std::thread &thread : threads) thread.join();
+}
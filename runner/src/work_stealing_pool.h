@@ -0,0 +1,29 @@
+/**********************************************************************************************
+*
+*   Work Stealing Pool - Runs task indices [0, count) across threads
+*
+*   Every worker starts with an even slice of the index range and pops from its front. A
+*   worker that runs dry steals the back half of another worker's slice. Slices are single
+*   64 bit atomics (begin and end packed), so popping and stealing are one CAS each and
+*   no lock is shared between cores.
+*
+**********************************************************************************************/
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <functional>
+
+typedef struct WorkerStats {
+    int tasksRun;
+    int tasksStolen;                // Tasks taken from other workers' slices
+    double busySeconds;             // Wall time spent inside tasks
+} WorkerStats;
+
+//----------------------------------------------------------------------------------
+// Work Stealing Pool Functions Declaration
+//----------------------------------------------------------------------------------
+// Blocks until every task ran once, task(index, worker) is called from worker threads
+void RunWorkStealing(int taskCount, int threadCount, const std::function<void(int task, int worker)> &task, WorkerStats *stats);
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,33 @@
+/**********************************************************************************************
+*
+*   Autopilot - Scripted and random SimInput sources for unattended games
+*
+*   Used by the headless tools to play without a keyboard. The random pilot draws from its
+*   own generator, so the game's PRNG sequence only depends on the game seed.
+*
+**********************************************************************************************/
+
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "simulation.h"
+#include "prng.h"
+
+typedef enum AutopilotMode {
+    AUTOPILOT_SCRIPTED = 0,         // Fixed turn/thrust pattern, always shooting
+    AUTOPILOT_RANDOM                // New random turn and thrust every few ticks, always shooting
+} AutopilotMode;
+
+typedef struct Autopilot {
+    AutopilotMode mode;
+    Prng rng;
+    SimInput current;               // Held by the random pilot between decisions
+} Autopilot;
+
+//----------------------------------------------------------------------------------
+// Autopilot Functions Declaration
+//----------------------------------------------------------------------------------
+void InitAutopilot(Autopilot *pilot, AutopilotMode mode, uint64_t seed);
+SimInput GetAutopilotInput(Autopilot *pilot, const GameState *state);
+
+#endif // AUTOPILOT_H
@@ -0,0 +1,53 @@
+/**********************************************************************************************
+*
+*   Collision Kernel - Batched two-stage narrow phase over broadphase candidate pairs
+*
+*   Candidate pairs are gathered into flat arrays first, then every stage runs as one loop
+*   over the whole batch:
+*
+*       1. RejectCollisionCircles()     bounding circles (swept along the relative motion),
+*                                       branch-free and vectorizable, drops most pairs
+*       2. SweepCircleAgainstShapes()   shot circle swept through the rotated target polygon
+*          OverlapShapeAgainstShapes()  rotated polygon against rotated polygon (SAT)
+*
+*   The first entity of a pair is the one being tested (a shot, the player), the second
+*   one is a target polygon (an asteroid). Stage 1 keeps the pair order, so results come
+*   out in the order pairs were pushed.
+*
+**********************************************************************************************/
+
+#ifndef COLLISION_KERNEL_H
+#define COLLISION_KERNEL_H
+
+#include "raylib.h"
+#include "collision_shape.h"
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct CollisionPairs {
+    int count;
+    std::vector<int> first;
+    std::vector<int> second;
+    std::vector<float> offsetX;         // First center relative to second center (at the start of the tick for sweeps)
+    std::vector<float> offsetY;
+    std::vector<float> motionX;         // Relative displacement over the tick, zero for static pairs
+    std::vector<float> motionY;
+    std::vector<float> reach;           // Sum of both bounding radii
+    std::vector<float> rotation;        // Second entity rotation, degrees
+    std::vector<unsigned char> shape;   // Second entity shape index
+    std::vector<float> time;            // Stage 2 result: first contact in [0, 1], -1 for no contact
+} CollisionPairs;
+
+//----------------------------------------------------------------------------------
+// Collision Kernel Functions Declaration
+//----------------------------------------------------------------------------------
+void ReserveCollisionPairs(CollisionPairs *pairs, int capacity);   // Sized up front so batches do not allocate
+void PushCollisionPair(CollisionPairs *pairs, int first, int second, Vector2 offset, Vector2 motion, float reach, float rotationDegrees, int shape);
+
+int RejectCollisionCircles(CollisionPairs *pairs);     // Stage 1, compacts the batch to the pairs within reach
+void SweepCircleAgainstShapes(CollisionPairs *pairs, float radius, const CollisionShape *shapes);
+void OverlapShapeAgainstShapes(CollisionPairs *pairs, const CollisionShape *shape, float rotationDegrees, const CollisionShape *shapes);
+
+#endif // COLLISION_KERNEL_H
@@ -0,0 +1,37 @@
+/**********************************************************************************************
+*
+*   Collision Shape - Convex hitbox polygons for sprites
+*
+*   A shape is a small convex polygon around the sprite center, in unrotated sprite space,
+*   plus the radius of the circle around the center that contains it. The circle rejects
+*   far pairs cheaply, the polygon decides the rest (see collision_kernel.h).
+*
+*   Shapes come from the sprite alpha channel (convex hull of the opaque pixels, reduced to
+*   COLLISION_SHAPE_MAX_VERTICES by dropping the vertices that lose the least area) or, when
+*   no image is at hand (headless tools), from the sprite size as a box.
+*
+**********************************************************************************************/
+
+#ifndef COLLISION_SHAPE_H
+#define COLLISION_SHAPE_H
+
+#include "raylib.h"
+
+#define COLLISION_SHAPE_MAX_VERTICES 8
+
+typedef struct CollisionShape {
+    int vertexCount;
+    Vector2 vertices[COLLISION_SHAPE_MAX_VERTICES];     // Hull order, relative to the sprite center
+    Vector2 normals[COLLISION_SHAPE_MAX_VERTICES];      // Unit outward normal of the edge starting at each vertex
+    float offsets[COLLISION_SHAPE_MAX_VERTICES];        // Distance of every edge from the center along its normal
+    float radius;                                       // Bounding circle around the sprite center
+} CollisionShape;
+
+//----------------------------------------------------------------------------------
+// Collision Shape Functions Declaration
+//----------------------------------------------------------------------------------
+CollisionShape GenCollisionShapeFromPoints(const Vector2 *points, int count);     // Convex hull of the points
+CollisionShape GenCollisionShapeBox(float width, float height);                   // Box centered on the sprite
+CollisionShape GenCollisionShapeFromAlpha(const unsigned char *alpha, int width, int height, int pixelStride, unsigned char threshold);
+
+#endif // COLLISION_SHAPE_H
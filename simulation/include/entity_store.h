@@ -0,0 +1,89 @@
+/**********************************************************************************************
+*
+*   Entity Store - Structure-of-arrays pools for asteroids and player shots
+*
+*   Only the fields read by the per-frame movement and collision passes live here, one
+*   contiguous array per field. Render-only data (sprites, sprite centers) is looked up
+*   per asteroid size at draw time instead of being copied into every entity.
+*
+*   Every pool is allocated once with a fixed capacity. Live entities are packed at the
+*   start of the arrays; dead ones are only flagged during the frame and removed by a
+*   single swap-remove pass. Entities spawned mid-frame stay pending (stored right after
+*   the live range, invisible to loops over [0, count)) until committed.
+*
+*   Slots hand out generation-tagged handles, so a handle kept across frames can detect
+*   that its entity was removed even if the slot got reused.
+*
+**********************************************************************************************/
+
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include "raylib.h"
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct EntityHandle {
+    int slot;                       // Slot index, -1 for an invalid handle
+    int generation;                 // Slot generation when the handle was created
+} EntityHandle;
+
+// Slot bookkeeping shared by all pools
+typedef struct EntitySlots {
+    int capacity;
+    int count;                      // Live entities, packed at [0, count)
+    int pendingCount;               // Spawned this frame, packed at [count, count + pendingCount)
+    std::vector<int> generation;    // Per slot, bumped every time the slot is released
+    std::vector<int> denseIndex;    // Per slot, array index of its entity (-1 if free)
+    std::vector<int> denseSlot;     // Per array index, slot owning that entity
+    std::vector<int> freeSlots;     // Free list, used as a stack
+    int freeCount;
+} EntitySlots;
+
+typedef struct AsteroidStore {
+    EntitySlots slots;
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> rotationDegrees;
+    std::vector<float> velocityX;       // Cached from the heading, which never changes after spawn
+    std::vector<float> velocityY;
+    std::vector<Rectangle> bounds;
+    std::vector<unsigned char> size;
+    std::vector<unsigned char> isActive;
+} AsteroidStore;
+
+typedef struct ShotStore {
+    EntitySlots slots;
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> rotationDegrees;
+    std::vector<float> velocityX;       // Cached from the heading, which never changes after spawn
+    std::vector<float> velocityY;
+    std::vector<Rectangle> bounds;
+    std::vector<int> framesLifespan;
+    std::vector<unsigned char> isActive;
+} ShotStore;
+
+//----------------------------------------------------------------------------------
+// Entity Store Functions Declaration
+//----------------------------------------------------------------------------------
+inline int GetAsteroidCount(const AsteroidStore &store) { return store.slots.count; }
+inline int GetShotCount(const ShotStore &store) { return store.slots.count; }
+
+int GetEntityIndex(const EntitySlots *slots, EntityHandle handle);     // Returns -1 if the entity is gone
+
+void InitAsteroids(AsteroidStore *store, int capacity);                 // Allocates all memory, once
+void ClearAsteroids(AsteroidStore *store);
+EntityHandle SpawnAsteroid(AsteroidStore *store, Vector2 position, float rotationDegrees, Vector2 velocity, int size, float width, float height);
+void CommitPendingAsteroids(AsteroidStore *store);
+void CompactAsteroids(AsteroidStore *store);                            // Swap-removes inactive asteroids
+
+void InitShots(ShotStore *store, int capacity);
+void ClearShots(ShotStore *store);
+EntityHandle SpawnShot(ShotStore *store, Vector2 position, float rotationDegrees, Vector2 velocity, float size, int framesLifespan);
+void CommitPendingShots(ShotStore *store);
+void CompactShots(ShotStore *store);                                    // Swap-removes inactive shots
+
+#endif // ENTITY_STORE_H
@@ -0,0 +1,91 @@
+/**********************************************************************************************
+*
+*   Leaderboard - Append-only run log with a top-N index
+*
+*   Every finished run is appended to <base>.runs as a fixed-size record and never
+*   rewritten. <base>.index holds the best LEADERBOARD_TOP_COUNT runs and the longest one,
+*   plus how many log records it covers; it is rebuilt atomically (temporary file and
+*   rename) after every append, so showing a ranking reads a few KB no matter how many
+*   runs the log holds. If the index is behind the log (crash between both writes) only
+*   the missing tail is folded in, a missing or damaged index is rebuilt by one streaming
+*   pass over the mapped log.
+*
+*   Fixed-size records at fixed offsets, so tools can mmap the log and index it directly
+*   (see MapLeaderboardRuns()). One writer at a time.
+*
+*   File layout, all values little-endian:
+*
+*       runs    "ASLB"  u32 version  u32 record size  u32 reserved
+*               record  i32 score  u32 ticks  u64 seed  i64 date  u32 flags  u32 checksum   (32 bytes)
+*
+*       index   "ASLI"  u32 version  u32 top count  u32 reserved  u64 runs covered
+*               entry   i32 score  u32 ticks  i64 date  u64 run     (longest run, then the top ones)
+*               u32 checksum of everything before it
+*
+*   Checksums are FNV-1a. A record failing its checksum is kept in the log but never ranked,
+*   a torn record at the end of the log (crash mid-append) is cut off on open.
+*
+**********************************************************************************************/
+
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LEADERBOARD_FORMAT_VERSION 1
+#define LEADERBOARD_TOP_COUNT 100
+#define LEADERBOARD_MAX_FILENAME 256
+
+// Run flags
+#define LEADERBOARD_RUN_IMPORTED 1      // Carried over from the old two-value storage file
+
+typedef struct LeaderboardRun {
+    int score;
+    unsigned int ticks;             // Survival time, SIM_TICKS_PER_SECOND per second
+    uint64_t seed;
+    int64_t date;                   // Unix time the run finished
+    unsigned int flags;
+} LeaderboardRun;
+
+typedef struct LeaderboardEntry {
+    int score;
+    unsigned int ticks;
+    int64_t date;
+    uint64_t run;                   // Record number in the log
+} LeaderboardEntry;
+
+// Higher score first, then longer survival, then the earlier run
+typedef struct LeaderboardTop {
+    int count;
+    LeaderboardEntry entries[LEADERBOARD_TOP_COUNT];
+    LeaderboardEntry longest;       // Longest survival of every run, ticks 0 when there is none
+    uint64_t runCount;              // Log records covered
+} LeaderboardTop;
+
+typedef struct Leaderboard {
+    char runsFileName[LEADERBOARD_MAX_FILENAME];
+    char indexFileName[LEADERBOARD_MAX_FILENAME];
+    LeaderboardTop top;
+} Leaderboard;
+
+// Read-only mapping of a runs file
+typedef struct LeaderboardView {
+    const unsigned char *data;
+    size_t size;
+    uint64_t count;                 // Complete records
+    void *handle;                   // Platform mapping handle
+} LeaderboardView;
+
+//----------------------------------------------------------------------------------
+// Leaderboard Functions Declaration
+//----------------------------------------------------------------------------------
+bool OpenLeaderboard(Leaderboard *board, const char *baseFileName);      // False if the runs file is not a leaderboard
+bool AppendLeaderboardRuns(Leaderboard *board, const LeaderboardRun *runs, int count);    // Log first, then the index
+int AddLeaderboardEntry(LeaderboardTop *top, LeaderboardEntry entry);    // Rank in the top (0 based), -1 if outside it
+
+bool MapLeaderboardRuns(LeaderboardView *view, const char *runsFileName);
+void UnmapLeaderboardRuns(LeaderboardView *view);
+bool GetLeaderboardViewRun(const LeaderboardView *view, uint64_t index, LeaderboardRun *run);   // False on a bad checksum
+
+#endif // LEADERBOARD_H
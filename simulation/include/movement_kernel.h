@@ -0,0 +1,25 @@
+/**********************************************************************************************
+*
+*   Movement Kernel - Batched move and screen wrap for entity arrays
+*
+*   Moves every entity by its cached velocity, stores the hitbox origin at the moved
+*   position and wraps the position back into the world, same order as the original
+*   per-object MoveObjectForwards(). SIMD variants are chosen at compile time (AVX2, SSE2
+*   or NEON) with a scalar fallback; all of them produce bit-identical results.
+*
+**********************************************************************************************/
+
+#ifndef MOVEMENT_KERNEL_H
+#define MOVEMENT_KERNEL_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Movement Kernel Functions Declaration
+//----------------------------------------------------------------------------------
+Vector2 GetHeadingVector(float rotationDegrees, float speed);     // Velocity for a heading, computed once
+void MoveAndWrapEntities(float *positionX, float *positionY, const float *velocityX, const float *velocityY,
+                         Rectangle *bounds, int count, float worldWidth, float worldHeight);
+const char *GetMovementKernelName(void);                          // Variant compiled in, for logging
+
+#endif // MOVEMENT_KERNEL_H
@@ -0,0 +1,27 @@
+/**********************************************************************************************
+*
+*   PRNG - Small seedable random generator (PCG32, XSH RR variant)
+*
+*   Each GameState owns one, so runs replay exactly from their seed and simulations on
+*   different threads never share generator state. 16 bytes, no locking.
+*
+**********************************************************************************************/
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+typedef struct Prng {
+    uint64_t state;
+    uint64_t increment;             // Stream selector, always odd
+} Prng;
+
+//----------------------------------------------------------------------------------
+// PRNG Functions Declaration
+//----------------------------------------------------------------------------------
+void SeedPrng(Prng *rng, uint64_t seed);
+uint32_t GetPrngNext(Prng *rng);                            // Uniform 32 bit value
+int GetPrngBounded(Prng *rng, int bound);                   // Uniform value in [0, bound), bound > 0
+
+#endif // PRNG_H
@@ -0,0 +1,70 @@
+/**********************************************************************************************
+*
+*   Profiler - Scoped phase timers recorded into a lock-free ring buffer
+*
+*   PROFILE_SCOPE("name") times the enclosing block and appends one event to a global ring
+*   buffer; any thread may record, a slot is claimed with a single atomic increment.
+*   PROFILE_FRAME_MARK() closes a frame so statistics can look at the last N frames.
+*   Names must be string literals, events keep the pointer.
+*
+*   Compiled in with ENABLE_PROFILER (on by default in debug builds, premake --profiler for
+*   release). Without it every macro expands to nothing and no profiler code is built.
+*
+**********************************************************************************************/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#if defined(DEBUG) && !defined(ENABLE_PROFILER)
+    #define ENABLE_PROFILER
+#endif
+
+#if defined(ENABLE_PROFILER)
+
+#include <stdint.h>
+
+#define PROFILER_RING_CAPACITY 65536    // Events kept, power of two, about 20 events per frame
+#define PROFILER_MAX_PHASES 32          // Distinct names reported by GetProfileStats()
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME_MARK() MarkProfileFrame()
+
+// Rolling statistics of one phase, durations in microseconds
+typedef struct ProfileStats {
+    const char *name;
+    int samples;
+    float p50;
+    float p95;
+    float p99;
+    float max;
+} ProfileStats;
+
+//----------------------------------------------------------------------------------
+// Profiler Functions Declaration
+//----------------------------------------------------------------------------------
+uint64_t GetProfileTime(void);                                          // Nanoseconds, monotonic
+void RecordProfileEvent(const char *name, uint64_t startTime, uint64_t endTime);
+void MarkProfileFrame(void);
+int GetProfileStats(ProfileStats *stats, int maxStats, int lastFrames); // Returns phases written, sorted by p50 descending
+bool ExportProfileCsv(const char *fileName);                            // Every event still in the ring
+bool ExportProfileChromeTrace(const char *fileName);                    // Load in chrome://tracing or Perfetto
+
+// Times its own lifetime
+struct ProfileScope {
+    const char *name;
+    uint64_t startTime;
+
+    explicit ProfileScope(const char *scopeName) : name(scopeName), startTime(GetProfileTime()) { }
+    ~ProfileScope() { RecordProfileEvent(name, startTime, GetProfileTime()); }
+};
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FRAME_MARK()
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,49 @@
+/**********************************************************************************************
+*
+*   Replay - Append-only input recording for deterministic playback
+*
+*   A replay is the seed and config a game started from followed by one record per tick:
+*   the SimInput fed to StepSimulation() and the state hash right after it. Records are
+*   streamed through stdio buffers as they are produced, so long sessions never sit in
+*   memory, and a truncated file still replays up to its last complete record.
+*
+*   File layout, all values little-endian:
+*
+*       header  "ASRP"  u32 version  u64 seed  SimConfig fields, tunables and shape hulls included (f32 bit patterns, i32)
+*       record  u8 input bits  u32 state hash                              (5 bytes/tick)
+*
+**********************************************************************************************/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "simulation.h"
+#include <stdio.h>
+#include <stdint.h>
+
+#define REPLAY_FORMAT_VERSION 5
+
+typedef struct ReplayWriter {
+    FILE *file;
+    int frames;                     // Records written so far
+} ReplayWriter;
+
+typedef struct ReplayReader {
+    FILE *file;
+    uint64_t seed;
+    SimConfig config;
+    int frames;                     // Records read so far
+} ReplayReader;
+
+//----------------------------------------------------------------------------------
+// Replay Functions Declaration
+//----------------------------------------------------------------------------------
+bool OpenReplayWriter(ReplayWriter *writer, const char *fileName, uint64_t seed, const SimConfig *config);
+void WriteReplayFrame(ReplayWriter *writer, SimInput input, uint32_t stateHash);
+void CloseReplayWriter(ReplayWriter *writer);
+
+bool OpenReplayReader(ReplayReader *reader, const char *fileName);     // Reads and validates the header
+bool ReadReplayFrame(ReplayReader *reader, SimInput *input, uint32_t *stateHash);   // False at end of stream
+void CloseReplayReader(ReplayReader *reader);
+
+#endif // REPLAY_H
@@ -0,0 +1,44 @@
+/**********************************************************************************************
+*
+*   Sim Snapshot - Flat copies of a GameState for restart, rewind and checkpoints
+*
+*   A snapshot is one contiguous, pointer-free byte buffer holding everything a step reads:
+*   config, seed, generator, frame counter, player, power-up and the live range of both
+*   entity pools (slot bookkeeping included, so handles stay valid across a restore).
+*   Scratch state rebuilt every step (broadphase grid, collision batch, hits, events) is
+*   not stored. The buffer can be copied, kept or compressed as plain bytes.
+*
+*   Loading never allocates: the target state must come from InitSimulation() with the
+*   same pool capacities, which LoadSimSnapshot() checks. Saving only allocates the first
+*   time, the buffer is sized for full pools.
+*
+*   Layout, native endianness (in-memory format, replays are the portable one):
+*
+*       header      SimSnapshotHeader
+*       asteroids   i32 generation[capacity]  i32 denseSlot[count]  i32 freeSlots[freeCount]  fields[count]
+*       shots       same
+*
+**********************************************************************************************/
+
+#ifndef SIM_SNAPSHOT_H
+#define SIM_SNAPSHOT_H
+
+#include "simulation.h"
+#include <vector>
+
+#define SIM_SNAPSHOT_VERSION 1
+
+typedef struct SimSnapshot {
+    std::vector<unsigned char> data;
+    int size;                       // Bytes in use, data.size() is the full-pool worst case
+    int framesCounter;              // Tick the snapshot was taken at
+} SimSnapshot;
+
+//----------------------------------------------------------------------------------
+// Sim Snapshot Functions Declaration
+//----------------------------------------------------------------------------------
+void SaveSimSnapshot(const GameState *state, SimSnapshot *snapshot);      // Call between steps
+bool LoadSimSnapshot(GameState *state, const unsigned char *data, int size);   // False if the data does not fit the state
+int GetSimSnapshotMaxSize(const SimConfig *config);                       // Buffer size for full pools
+
+#endif // SIM_SNAPSHOT_H
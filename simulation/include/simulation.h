@@ -0,0 +1,147 @@
+/**********************************************************************************************
+*
+*   Simulation - Headless gameplay core for ASTEROIDS
+*
+*   All gameplay rules live here, with no dependency on the window, input or audio
+*   backends: raylib.h is only included for its math types. The gameplay screen turns
+*   keyboard state into a SimInput, calls StepSimulation() once per frame and reacts to
+*   the events raised by the step (sounds, game over).
+*
+*   Everything a step reads or writes is inside GameState, so several games can be
+*   simulated side by side.
+*
+**********************************************************************************************/
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"
+#include "entity_store.h"
+#include "spatial_grid.h"
+#include "collision_shape.h"
+#include "collision_kernel.h"
+#include "prng.h"
+#include <vector>
+
+#define SIM_TICKS_PER_SECOND 60
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+
+// Player intent for one step
+typedef struct SimInput {
+    int rotation;                   // -1 turn left, 1 turn right, 0 none
+    int thrust;                     // 1 forwards, -1 backwards, 0 none
+    bool shoot;
+    bool quit;
+} SimInput;
+
+// Flags raised by a step, cleared at the start of the next one
+typedef enum SimEvent {
+    SIM_EVENT_SHOT              = 1 << 0,
+    SIM_EVENT_ASTEROID_HIT      = 1 << 1,
+    SIM_EVENT_PLAYER_DAMAGED    = 1 << 2,
+    SIM_EVENT_POWERUP_PICKED    = 1 << 3,
+    SIM_EVENT_THRUST            = 1 << 4,
+    SIM_EVENT_GAME_OVER         = 1 << 5
+} SimEvent;
+
+// Asteroid destroyed by a step, where it was and how big, for effects
+typedef struct SimHit {
+    Vector2 position;
+    int size;
+} SimHit;
+
+// World and hitbox sizes (hitboxes match the sprite sizes) and gameplay tunables
+typedef struct SimConfig {
+    float worldWidth;
+    float worldHeight;
+    Vector2 playerSize;
+    Vector2 asteroidSizes[4];       // Indexed by asteroid size, index 0 unused
+    Vector2 powerUpSize;
+    CollisionShape playerShape;     // Narrow phase shapes, centered on the position and rotated with the sprite
+    CollisionShape asteroidShapes[4];
+    int asteroidCapacity;
+    int shotCapacity;
+
+    // Gameplay tunables, speeds in pixels per tick, durations in ticks
+    float asteroidSpeed;
+    float shotSpeed;
+    float shotSize;
+    int shotFramesLifespan;
+    int playerShotCooldownFrames;
+    int playerInvencibilityFrames;
+    int playerPowerUpLifespan;
+    int powerUpFramesLifespan;
+    int powerUpGenerationRate;      // A power-up may spawn (50%) every this many ticks
+    int powerUpShotCount;           // Shots per trigger while the power-up lasts
+    int multipleShotDeviationDegrees;
+
+    int stressAsteroidCount;        // Stress mode when > 0: field kept at this many asteroids, auto-fire, player can not die
+} SimConfig;
+
+typedef struct Player {
+    float spriteAlpha;
+    Vector2 position;
+    Vector2 previousPosition;       // Position and rotation one tick ago, for render interpolation
+    float previousRotationDegrees;
+    Vector2 currentInput;           // x: thrust, y: rotation
+    float rotationDegrees;
+    Vector2 heading;                // Unit vector, only recomputed when rotationDegrees changes
+    float rotationAlpha;
+    float currentSpeed;
+    float speedAlpha;
+    float decelerationRate;
+    bool isShootInCooldown;
+    int lastShootFrameNumber;
+    Rectangle bounds;
+    int lives;
+    int score;
+    bool isShootingKeyActive;
+    int lastDamageFrameCounter;
+    bool isInvulnerable;
+    bool hasPowerUp;
+    int powerUpFramesLeft;
+} Player;
+
+typedef struct PlayerPowerUp {
+    Vector2 position;
+    Rectangle bounds;
+    int frameslifespan;
+    bool isActive;
+} PlayerPowerUp;
+
+typedef struct GameState {
+    SimConfig config;
+    uint64_t seed;                  // Seed the game started from
+    Prng rng;                       // Every random roll of the game comes from here
+    Player player;
+    PlayerPowerUp powerUp;
+    AsteroidStore asteroids;        // Split asteroids stay pending until the end of the step
+    ShotStore shots;
+    SpatialGrid asteroidsGrid;
+    std::vector<int> broadphaseCandidates;
+    CollisionPairs collisionPairs;  // Narrow phase batch, reused by every collision pass
+    float maxAsteroidRadius;        // Broadphase queries grow by it, shapes are centered but grid bounds are not
+    int framesCounter;
+    bool isFinished;                // Player died or quit
+    unsigned int events;            // SimEvent flags raised by the last step
+    std::vector<SimHit> hits;       // Asteroids destroyed by the last step, cleared with events (not part of the hash)
+    bool isVerifyingBroadphase;     // Cross-check every broadphase query against all asteroids, slow, off after init
+    long long broadphaseMisses;     // Pairs the cross-check found missing from the broadphase candidates
+} GameState;
+
+//----------------------------------------------------------------------------------
+// Simulation Functions Declaration
+//----------------------------------------------------------------------------------
+SimConfig GetDefaultSimConfig(void);                        // Screen and sprite sizes of the shipped game, box shapes
+void SetSimConfigStress(SimConfig *config, int asteroidCount);     // Stress mode with pools sized for asteroidCount
+bool IsSimConfigValid(const SimConfig *config);              // Sizes, capacities and tunables InitSimulation() can run with
+void InitSimulation(GameState *state, const SimConfig *config, uint64_t seed);   // Same seed and inputs, same game
+void UnloadSimulation(GameState *state);
+void StepSimulation(GameState *state, SimInput input);      // Advance one tick (1/SIM_TICKS_PER_SECOND)
+float GetSimulationTime(const GameState *state);            // Seconds simulated since init
+uint32_t GetSimulationHash(const GameState *state);         // Gameplay state digest, equal hashes on the same tick mean no desync
+
+#endif // SIMULATION_H
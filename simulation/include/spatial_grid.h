@@ -0,0 +1,39 @@
+/**********************************************************************************************
+*
+*   Spatial Grid - Uniform grid broadphase for a screen-wrapped world
+*
+*   The grid is rebuilt from scratch every frame. Cells tile the world exactly, so a
+*   coordinate that left the screen on one side maps to the cells on the opposite side,
+*   matching the wrap-around applied by MoveAndWrapEntities() in the movement kernel.
+*
+**********************************************************************************************/
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "raylib.h"
+#include <vector>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SpatialGrid {
+    int columns;
+    int rows;
+    float cellWidth;
+    float cellHeight;
+    std::vector<int> cellStart;     // Offset of every cell into cellItems (columns*rows + 1 entries)
+    std::vector<int> cellCursor;    // Scratch write cursor used while bucketing
+    std::vector<int> cellItems;     // Item indices bucketed by cell, ascending inside every cell
+    std::vector<int> queryStamp;    // Last query that reported each item, avoids duplicates
+    int queryCounter;
+} SpatialGrid;
+
+//----------------------------------------------------------------------------------
+// Spatial Grid Functions Declaration
+//----------------------------------------------------------------------------------
+void InitSpatialGrid(SpatialGrid *grid, float worldWidth, float worldHeight, float cellSize, int itemCapacity);
+void BuildSpatialGrid(SpatialGrid *grid, const Rectangle *bounds, int count);
+int QuerySpatialGrid(SpatialGrid *grid, Rectangle area, std::vector<int> *result);   // Result is sorted ascending
+
+#endif // SPATIAL_GRID_H
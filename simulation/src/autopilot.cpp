@@ -0,0 +1,49 @@
+/**********************************************************************************************
+*
+*   Autopilot - Scripted and random SimInput sources for unattended games
+*
+**********************************************************************************************/
+
+#include "autopilot.h"
+
+#define AUTOPILOT_SCRIPT_PHASE_TICKS 90     // Scripted pilot: thrust, turn right, coast, turn left
+#define AUTOPILOT_DECISION_TICKS 15         // Random pilot: ticks an input is held
+
+//----------------------------------------------------------------------------------
+// Autopilot Functions Definition
+//----------------------------------------------------------------------------------
+void InitAutopilot(Autopilot *pilot, AutopilotMode mode, uint64_t seed)
+{
+    pilot->mode = mode;
+    pilot->current = SimInput{ 0 };
+
+    // Separate stream from the game seeded with the same value
+    SeedPrng(&pilot->rng, seed ^ 0x9e3779b97f4a7c15ULL);
+}
+
+SimInput GetAutopilotInput(Autopilot *pilot, const GameState *state)
+{
+    SimInput input = { 0 };
+
+    if (pilot->mode == AUTOPILOT_SCRIPTED)
+    {
+        int phase = (state->framesCounter/AUTOPILOT_SCRIPT_PHASE_TICKS)%4;
+
+        input.rotation = (phase == 1)? 1 : ((phase == 3)? -1 : 0);
+        input.thrust = (phase == 0)? 1 : 0;
+    }
+    else
+    {
+        if ((state->framesCounter%AUTOPILOT_DECISION_TICKS) == 0)
+        {
+            pilot->current.rotation = GetPrngBounded(&pilot->rng, 3) - 1;
+            pilot->current.thrust = GetPrngBounded(&pilot->rng, 3) - 1;
+        }
+
+        input = pilot->current;
+    }
+
+    input.shoot = true;
+
+    return input;
+}
@@ -0,0 +1,198 @@
+/**********************************************************************************************
+*
+*   Collision Kernel - Batched two-stage narrow phase over broadphase candidate pairs
+*
+**********************************************************************************************/
+
+#include "collision_kernel.h"
+#include <math.h>                   // Required for: cosf(), sinf(), INFINITY
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Into the unrotated frame of a shape rotated by (cosRotation, sinRotation), same convention as DrawTexturePro()
+static Vector2 unrotate(float x, float y, float cosRotation, float sinRotation)
+{
+    return { cosRotation*x + sinRotation*y, -sinRotation*x + cosRotation*y };
+}
+
+static void projectPolygon(const Vector2 *vertices, int count, Vector2 axis, float *min, float *max)
+{
+    *min = INFINITY;
+    *max = -INFINITY;
+
+    for (int i = 0; i < count; i++)
+    {
+        float projection = vertices[i].x*axis.x + vertices[i].y*axis.y;
+        *min = std::min(*min, projection);
+        *max = std::max(*max, projection);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Collision Kernel Functions Definition
+//----------------------------------------------------------------------------------
+void ReserveCollisionPairs(CollisionPairs *pairs, int capacity)
+{
+    pairs->count = 0;
+    pairs->first.resize(capacity);
+    pairs->second.resize(capacity);
+    pairs->offsetX.resize(capacity);
+    pairs->offsetY.resize(capacity);
+    pairs->motionX.resize(capacity);
+    pairs->motionY.resize(capacity);
+    pairs->reach.resize(capacity);
+    pairs->rotation.resize(capacity);
+    pairs->shape.resize(capacity);
+    pairs->time.resize(capacity);
+}
+
+void PushCollisionPair(CollisionPairs *pairs, int first, int second, Vector2 offset, Vector2 motion, float reach, float rotationDegrees, int shape)
+{
+    int i = pairs->count;
+
+    // Dense fields can exceed the reserve, the batch then grows once and keeps its size
+    if (i == (int)pairs->first.size())
+    {
+        ReserveCollisionPairs(pairs, i*2 + 64);
+        pairs->count = i;
+    }
+
+    pairs->first[i] = first;
+    pairs->second[i] = second;
+    pairs->offsetX[i] = offset.x;
+    pairs->offsetY[i] = offset.y;
+    pairs->motionX[i] = motion.x;
+    pairs->motionY[i] = motion.y;
+    pairs->reach[i] = reach;
+    pairs->rotation[i] = rotationDegrees;
+    pairs->shape[i] = (unsigned char)shape;
+    pairs->count++;
+}
+
+// Closest approach of the two centers along the relative motion against the sum of radii,
+// written without branches so the first loop vectorizes; survivors are then packed in order
+int RejectCollisionCircles(CollisionPairs *pairs)
+{
+    int count = pairs->count;
+    float *offsetX = pairs->offsetX.data();
+    float *offsetY = pairs->offsetY.data();
+    float *motionX = pairs->motionX.data();
+    float *motionY = pairs->motionY.data();
+    float *reach = pairs->reach.data();
+    float *inReach = pairs->time.data();        // Stage 2 overwrites it, reused as the keep mask
+
+    for (int i = 0; i < count; i++)
+    {
+        float motionLength = motionX[i]*motionX[i] + motionY[i]*motionY[i];
+        float along = -(offsetX[i]*motionX[i] + offsetY[i]*motionY[i])/((motionLength > 0.0f)? motionLength : 1.0f);
+        float t = std::min(std::max(along, 0.0f), 1.0f);
+        float closestX = offsetX[i] + t*motionX[i];
+        float closestY = offsetY[i] + t*motionY[i];
+
+        inReach[i] = ((closestX*closestX + closestY*closestY) < reach[i]*reach[i])? 1.0f : 0.0f;
+    }
+
+    int kept = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (inReach[i] == 0.0f) continue;
+
+        pairs->first[kept] = pairs->first[i];
+        pairs->second[kept] = pairs->second[i];
+        offsetX[kept] = offsetX[i];
+        offsetY[kept] = offsetY[i];
+        motionX[kept] = motionX[i];
+        motionY[kept] = motionY[i];
+        reach[kept] = reach[i];
+        pairs->rotation[kept] = pairs->rotation[i];
+        pairs->shape[kept] = pairs->shape[i];
+        kept++;
+    }
+
+    pairs->count = kept;
+
+    return kept;
+}
+
+// Clips the relative path against every edge of the target polygon pushed out by the circle radius
+// NOTE: Pushed-out edges overshoot the rounded corners a little, never undershoot
+void SweepCircleAgainstShapes(CollisionPairs *pairs, float radius, const CollisionShape *shapes)
+{
+    for (int i = 0; i < pairs->count; i++)
+    {
+        const CollisionShape &shape = shapes[pairs->shape[i]];
+        float radians = pairs->rotation[i]*DEG2RAD;
+        float cosRotation = cosf(radians);
+        float sinRotation = sinf(radians);
+
+        Vector2 start = unrotate(pairs->offsetX[i], pairs->offsetY[i], cosRotation, sinRotation);
+        Vector2 motion = unrotate(pairs->motionX[i], pairs->motionY[i], cosRotation, sinRotation);
+        float enterTime = 0.0f;
+        float exitTime = 1.0f;
+
+        for (int k = 0; (k < shape.vertexCount) && (enterTime < exitTime); k++)
+        {
+            Vector2 normal = shape.normals[k];
+            float distance = shape.offsets[k] + radius - (normal.x*start.x + normal.y*start.y);
+            float approach = normal.x*motion.x + normal.y*motion.y;
+
+            if (approach == 0.0f)
+            {
+                if (distance <= 0.0f) exitTime = -1.0f;     // Parallel and outside
+            }
+            else if (approach > 0.0f) exitTime = std::min(exitTime, distance/approach);
+            else enterTime = std::max(enterTime, distance/approach);
+        }
+
+        pairs->time[i] = (enterTime < exitTime)? enterTime : -1.0f;
+    }
+}
+
+// Separating axis test in the target frame: the first shape is brought into it once per pair
+void OverlapShapeAgainstShapes(CollisionPairs *pairs, const CollisionShape *shape, float rotationDegrees, const CollisionShape *shapes)
+{
+    Vector2 vertices[COLLISION_SHAPE_MAX_VERTICES];
+    Vector2 normals[COLLISION_SHAPE_MAX_VERTICES];
+
+    for (int i = 0; i < pairs->count; i++)
+    {
+        const CollisionShape &target = shapes[pairs->shape[i]];
+        float targetRadians = pairs->rotation[i]*DEG2RAD;
+        float cosTarget = cosf(targetRadians);
+        float sinTarget = sinf(targetRadians);
+        float relativeRadians = (rotationDegrees - pairs->rotation[i])*DEG2RAD;
+        float cosRelative = cosf(relativeRadians);
+        float sinRelative = sinf(relativeRadians);
+
+        Vector2 offset = unrotate(pairs->offsetX[i], pairs->offsetY[i], cosTarget, sinTarget);
+
+        for (int k = 0; k < shape->vertexCount; k++)
+        {
+            Vector2 vertex = shape->vertices[k];
+            Vector2 normal = shape->normals[k];
+
+            vertices[k] = { cosRelative*vertex.x - sinRelative*vertex.y + offset.x, sinRelative*vertex.x + cosRelative*vertex.y + offset.y };
+            normals[k] = { cosRelative*normal.x - sinRelative*normal.y, sinRelative*normal.x + cosRelative*normal.y };
+        }
+
+        // Touching edges do not count, same as CheckCollisionRecs()
+        bool isSeparated = false;
+
+        for (int k = 0; (k < target.vertexCount + shape->vertexCount) && !isSeparated; k++)
+        {
+            Vector2 axis = (k < target.vertexCount)? target.normals[k] : normals[k - target.vertexCount];
+            float minA, maxA, minB, maxB;
+
+            projectPolygon(target.vertices, target.vertexCount, axis, &minA, &maxA);
+            projectPolygon(vertices, shape->vertexCount, axis, &minB, &maxB);
+
+            isSeparated = (maxA <= minB) || (maxB <= minA);
+        }
+
+        pairs->time[i] = isSeparated? -1.0f : 0.0f;
+    }
+}
@@ -0,0 +1,145 @@
+/**********************************************************************************************
+*
+*   Collision Shape - Convex hitbox polygons for sprites
+*
+**********************************************************************************************/
+
+#include "collision_shape.h"
+#include <math.h>                   // Required for: sqrtf(), fabsf(), INFINITY
+#include <vector>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Twice the signed area of the triangle (a, b, c), positive when c lies to the left of a->b
+static float getTurn(Vector2 a, Vector2 b, Vector2 c)
+{
+    return (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x);
+}
+
+// Monotone chain, collinear points dropped
+static std::vector<Vector2> getConvexHull(std::vector<Vector2> points)
+{
+    std::sort(points.begin(), points.end(), [](Vector2 a, Vector2 b) { return (a.x != b.x)? (a.x < b.x) : (a.y < b.y); });
+    points.erase(std::unique(points.begin(), points.end(), [](Vector2 a, Vector2 b) { return (a.x == b.x) && (a.y == b.y); }), points.end());
+
+    if (points.size() < 3) return points;
+
+    std::vector<Vector2> hull(points.size()*2);
+    int count = 0;
+
+    // Lower chain, then upper chain
+    for (int i = 0; i < (int)points.size(); i++)
+    {
+        while ((count >= 2) && (getTurn(hull[count - 2], hull[count - 1], points[i]) <= 0.0f)) count--;
+        hull[count++] = points[i];
+    }
+
+    for (int i = (int)points.size() - 2, lowerCount = count + 1; i >= 0; i--)
+    {
+        while ((count >= lowerCount) && (getTurn(hull[count - 2], hull[count - 1], points[i]) <= 0.0f)) count--;
+        hull[count++] = points[i];
+    }
+
+    hull.resize(count - 1);     // Last point repeats the first one
+
+    return hull;
+}
+
+//----------------------------------------------------------------------------------
+// Collision Shape Functions Definition
+//----------------------------------------------------------------------------------
+CollisionShape GenCollisionShapeFromPoints(const Vector2 *points, int count)
+{
+    std::vector<Vector2> hull = getConvexHull(std::vector<Vector2>(points, points + count));
+
+    // Degenerate input (a line or a dot) still gets a usable area
+    if (hull.size() < 3)
+    {
+        float extentX = 0.5f;
+        float extentY = 0.5f;
+        for (Vector2 point : hull)
+        {
+            extentX = std::max(extentX, fabsf(point.x));
+            extentY = std::max(extentY, fabsf(point.y));
+        }
+
+        return GenCollisionShapeBox(extentX*2.0f, extentY*2.0f);
+    }
+
+    // Drop the vertex spanning the smallest triangle with its neighbours until the hull fits
+    while (hull.size() > COLLISION_SHAPE_MAX_VERTICES)
+    {
+        int count = (int)hull.size();
+        int smallest = 0;
+        float smallestArea = INFINITY;
+
+        for (int i = 0; i < count; i++)
+        {
+            float area = getTurn(hull[(i + count - 1)%count], hull[i], hull[(i + 1)%count]);
+            if (area < smallestArea)
+            {
+                smallest = i;
+                smallestArea = area;
+            }
+        }
+
+        hull.erase(hull.begin() + smallest);
+    }
+
+    CollisionShape shape = { 0 };
+    shape.vertexCount = (int)hull.size();
+
+    for (int i = 0; i < shape.vertexCount; i++)
+    {
+        Vector2 start = hull[i];
+        Vector2 end = hull[(i + 1)%shape.vertexCount];
+        Vector2 edge = { end.x - start.x, end.y - start.y };
+        float length = sqrtf(edge.x*edge.x + edge.y*edge.y);
+
+        shape.vertices[i] = start;
+        shape.normals[i] = { edge.y/length, -edge.x/length };
+        shape.offsets[i] = shape.normals[i].x*start.x + shape.normals[i].y*start.y;
+        shape.radius = std::max(shape.radius, sqrtf(start.x*start.x + start.y*start.y));
+    }
+
+    return shape;
+}
+
+CollisionShape GenCollisionShapeBox(float width, float height)
+{
+    Vector2 corners[4] = { { -width/2, -height/2 }, { width/2, -height/2 }, { width/2, height/2 }, { -width/2, height/2 } };
+
+    return GenCollisionShapeFromPoints(corners, 4);
+}
+
+// NOTE: Only the outermost opaque pixel of every row can be on the hull, so each row adds
+// at most the four outer corners of those two pixels
+CollisionShape GenCollisionShapeFromAlpha(const unsigned char *alpha, int width, int height, int pixelStride, unsigned char threshold)
+{
+    std::vector<Vector2> points;
+    float centerX = width/2.0f;
+    float centerY = height/2.0f;
+
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *row = alpha + (size_t)y*width*pixelStride;
+        int left = 0;
+        int right = width - 1;
+
+        while ((left < width) && (row[left*pixelStride] < threshold)) left++;
+        if (left == width) continue;
+        while (row[right*pixelStride] < threshold) right--;
+
+        points.push_back({ left - centerX, y - centerY });
+        points.push_back({ left - centerX, y + 1 - centerY });
+        points.push_back({ right + 1 - centerX, y - centerY });
+        points.push_back({ right + 1 - centerX, y + 1 - centerY });
+    }
+
+    if (points.empty()) return GenCollisionShapeBox((float)width, (float)height);
+
+    return GenCollisionShapeFromPoints(points.data(), (int)points.size());
+}
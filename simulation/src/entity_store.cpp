@@ -0,0 +1,244 @@
+/**********************************************************************************************
+*
+*   Entity Store - Structure-of-arrays pools for asteroids and player shots
+*
+**********************************************************************************************/
+
+#include "entity_store.h"
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+static void InitEntitySlots(EntitySlots *slots, int capacity)
+{
+    slots->capacity = capacity;
+    slots->count = 0;
+    slots->pendingCount = 0;
+    slots->freeCount = 0;
+    slots->generation.assign(capacity, 0);
+    slots->denseIndex.resize(capacity);
+    slots->denseSlot.resize(capacity);
+    slots->freeSlots.resize(capacity);
+}
+
+// Release every slot, generations are kept so old handles stay invalid
+static void ResetEntitySlots(EntitySlots *slots)
+{
+    for (int i = 0; i < slots->count + slots->pendingCount; i++) slots->generation[slots->denseSlot[i]]++;
+
+    slots->count = 0;
+    slots->pendingCount = 0;
+    slots->freeCount = slots->capacity;
+
+    for (int i = 0; i < slots->capacity; i++)
+    {
+        slots->denseIndex[i] = -1;
+        slots->freeSlots[i] = slots->capacity - 1 - i;  // Lower slots are handed out first
+    }
+}
+
+// Take a free slot for a new pending entity, returns its array index or -1 if the pool is full
+static int AllocateEntity(EntitySlots *slots, EntityHandle *handle)
+{
+    if (slots->freeCount == 0)
+    {
+        *handle = { -1, 0 };
+        return -1;
+    }
+
+    int slot = slots->freeSlots[--slots->freeCount];
+    int index = slots->count + slots->pendingCount++;
+
+    slots->denseIndex[slot] = index;
+    slots->denseSlot[index] = slot;
+    *handle = { slot, slots->generation[slot] };
+
+    return index;
+}
+
+// Release the entity at index and move the last live entity into its place
+// NOTE: Returns the index whose data must be copied into index, or index itself if nothing moved.
+// Pending entities must be committed before compacting, otherwise they would be overwritten
+static int ReleaseEntity(EntitySlots *slots, int index)
+{
+    int last = slots->count - 1;
+    int slot = slots->denseSlot[index];
+
+    slots->generation[slot]++;
+    slots->denseIndex[slot] = -1;
+    slots->freeSlots[slots->freeCount++] = slot;
+
+    if (index != last)
+    {
+        int movedSlot = slots->denseSlot[last];
+        slots->denseSlot[index] = movedSlot;
+        slots->denseIndex[movedSlot] = index;
+    }
+
+    slots->count--;
+
+    return last;
+}
+
+//----------------------------------------------------------------------------------
+// Entity Store Functions Definition
+//----------------------------------------------------------------------------------
+int GetEntityIndex(const EntitySlots *slots, EntityHandle handle)
+{
+    if ((handle.slot < 0) || (handle.slot >= slots->capacity)) return -1;
+    if (slots->generation[handle.slot] != handle.generation) return -1;
+
+    return slots->denseIndex[handle.slot];
+}
+
+void InitAsteroids(AsteroidStore *store, int capacity)
+{
+    InitEntitySlots(&store->slots, capacity);
+
+    store->positionX.resize(capacity);
+    store->positionY.resize(capacity);
+    store->rotationDegrees.resize(capacity);
+    store->velocityX.resize(capacity);
+    store->velocityY.resize(capacity);
+    store->bounds.resize(capacity);
+    store->size.resize(capacity);
+    store->isActive.resize(capacity);
+
+    ResetEntitySlots(&store->slots);
+}
+
+void ClearAsteroids(AsteroidStore *store)
+{
+    ResetEntitySlots(&store->slots);
+}
+
+// NOTE: Hitbox is anchored at position, same as the player and the shots
+EntityHandle SpawnAsteroid(AsteroidStore *store, Vector2 position, float rotationDegrees, Vector2 velocity, int size, float width, float height)
+{
+    EntityHandle handle;
+    int i = AllocateEntity(&store->slots, &handle);
+
+    if (i >= 0)
+    {
+        store->positionX[i] = position.x;
+        store->positionY[i] = position.y;
+        store->rotationDegrees[i] = rotationDegrees;
+        store->velocityX[i] = velocity.x;
+        store->velocityY[i] = velocity.y;
+        store->bounds[i] = { position.x, position.y, width, height };
+        store->size[i] = (unsigned char)size;
+        store->isActive[i] = true;
+    }
+
+    return handle;
+}
+
+void CommitPendingAsteroids(AsteroidStore *store)
+{
+    store->slots.count += store->slots.pendingCount;
+    store->slots.pendingCount = 0;
+}
+
+void CompactAsteroids(AsteroidStore *store)
+{
+    int i = 0;
+
+    while (i < store->slots.count)
+    {
+        if (store->isActive[i])
+        {
+            i++;
+            continue;
+        }
+
+        int last = ReleaseEntity(&store->slots, i);
+
+        // The moved asteroid is checked again on the next iteration
+        if (last != i)
+        {
+            store->positionX[i] = store->positionX[last];
+            store->positionY[i] = store->positionY[last];
+            store->rotationDegrees[i] = store->rotationDegrees[last];
+            store->velocityX[i] = store->velocityX[last];
+            store->velocityY[i] = store->velocityY[last];
+            store->bounds[i] = store->bounds[last];
+            store->size[i] = store->size[last];
+            store->isActive[i] = store->isActive[last];
+        }
+    }
+}
+
+void InitShots(ShotStore *store, int capacity)
+{
+    InitEntitySlots(&store->slots, capacity);
+
+    store->positionX.resize(capacity);
+    store->positionY.resize(capacity);
+    store->rotationDegrees.resize(capacity);
+    store->velocityX.resize(capacity);
+    store->velocityY.resize(capacity);
+    store->bounds.resize(capacity);
+    store->framesLifespan.resize(capacity);
+    store->isActive.resize(capacity);
+
+    ResetEntitySlots(&store->slots);
+}
+
+void ClearShots(ShotStore *store)
+{
+    ResetEntitySlots(&store->slots);
+}
+
+EntityHandle SpawnShot(ShotStore *store, Vector2 position, float rotationDegrees, Vector2 velocity, float size, int framesLifespan)
+{
+    EntityHandle handle;
+    int i = AllocateEntity(&store->slots, &handle);
+
+    if (i >= 0)
+    {
+        store->positionX[i] = position.x;
+        store->positionY[i] = position.y;
+        store->rotationDegrees[i] = rotationDegrees;
+        store->velocityX[i] = velocity.x;
+        store->velocityY[i] = velocity.y;
+        store->bounds[i] = { position.x, position.y, size, size };
+        store->framesLifespan[i] = framesLifespan;
+        store->isActive[i] = true;
+    }
+
+    return handle;
+}
+
+void CommitPendingShots(ShotStore *store)
+{
+    store->slots.count += store->slots.pendingCount;
+    store->slots.pendingCount = 0;
+}
+
+void CompactShots(ShotStore *store)
+{
+    int i = 0;
+
+    while (i < store->slots.count)
+    {
+        if (store->isActive[i])
+        {
+            i++;
+            continue;
+        }
+
+        int last = ReleaseEntity(&store->slots, i);
+
+        if (last != i)
+        {
+            store->positionX[i] = store->positionX[last];
+            store->positionY[i] = store->positionY[last];
+            store->rotationDegrees[i] = store->rotationDegrees[last];
+            store->velocityX[i] = store->velocityX[last];
+            store->velocityY[i] = store->velocityY[last];
+            store->bounds[i] = store->bounds[last];
+            store->framesLifespan[i] = store->framesLifespan[last];
+            store->isActive[i] = store->isActive[last];
+        }
+    }
+}
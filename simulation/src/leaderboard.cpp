@@ -0,0 +1,396 @@
+/**********************************************************************************************
+*
+*   Leaderboard - Append-only run log with a top-N index
+*
+**********************************************************************************************/
+
+#include "leaderboard.h"
+#include <stdio.h>                  // Required for: fopen(), fread(), fwrite(), fclose(), snprintf(), remove()
+#include <string.h>                 // Required for: memcmp(), memcpy()
+#include <filesystem>               // Required for: std::filesystem::rename(), resize_file(), file_size()
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI
+    #define NOUSER
+    #include <windows.h>            // Required for: CreateFileMappingA(), MapViewOfFile()
+    #include <io.h>                 // Required for: _commit(), _fileno()
+#else
+    #include <sys/mman.h>           // Required for: mmap(), munmap()
+    #include <sys/stat.h>           // Required for: fstat()
+    #include <fcntl.h>              // Required for: open()
+    #include <unistd.h>             // Required for: close(), fsync()
+#endif
+
+#define RUNS_HEADER_SIZE 16
+#define RUN_RECORD_SIZE 32
+#define INDEX_HEADER_SIZE 24
+#define INDEX_ENTRY_SIZE 24
+#define APPEND_BATCH_RUNS 256       // Records encoded per fwrite()
+
+static const char runsMagic[4] = { 'A', 'S', 'L', 'B' };
+static const char indexMagic[4] = { 'A', 'S', 'L', 'I' };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Fixed byte order so leaderboards move between machines
+static void putU32(unsigned char *bytes, uint32_t value)
+{
+    bytes[0] = (unsigned char)value;
+    bytes[1] = (unsigned char)(value >> 8);
+    bytes[2] = (unsigned char)(value >> 16);
+    bytes[3] = (unsigned char)(value >> 24);
+}
+
+static void putU64(unsigned char *bytes, uint64_t value)
+{
+    putU32(bytes, (uint32_t)value);
+    putU32(bytes + 4, (uint32_t)(value >> 32));
+}
+
+static uint32_t getU32(const unsigned char *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static uint64_t getU64(const unsigned char *bytes)
+{
+    return (uint64_t)getU32(bytes) | ((uint64_t)getU32(bytes + 4) << 32);
+}
+
+static uint32_t getChecksum(const unsigned char *bytes, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) hash = (hash ^ bytes[i])*16777619u;
+
+    return hash;
+}
+
+static void encodeRun(unsigned char *bytes, const LeaderboardRun &run)
+{
+    putU32(bytes, (uint32_t)run.score);
+    putU32(bytes + 4, run.ticks);
+    putU64(bytes + 8, run.seed);
+    putU64(bytes + 16, (uint64_t)run.date);
+    putU32(bytes + 24, run.flags);
+    putU32(bytes + 28, getChecksum(bytes, RUN_RECORD_SIZE - 4));
+}
+
+static void encodeEntry(unsigned char *bytes, const LeaderboardEntry &entry)
+{
+    putU32(bytes, (uint32_t)entry.score);
+    putU32(bytes + 4, entry.ticks);
+    putU64(bytes + 8, (uint64_t)entry.date);
+    putU64(bytes + 16, entry.run);
+}
+
+static LeaderboardEntry decodeEntry(const unsigned char *bytes)
+{
+    return { (int)getU32(bytes), getU32(bytes + 4), (int64_t)getU64(bytes + 8), getU64(bytes + 16) };
+}
+
+static bool isEntryAhead(const LeaderboardEntry &a, const LeaderboardEntry &b)
+{
+    if (a.score != b.score) return a.score > b.score;
+    if (a.ticks != b.ticks) return a.ticks > b.ticks;
+
+    return a.run < b.run;
+}
+
+static bool syncFile(FILE *file)
+{
+    if (fflush(file) != 0) return false;
+#if defined(_WIN32)
+    return (_commit(_fileno(file)) == 0);
+#else
+    return (fsync(fileno(file)) == 0);
+#endif
+}
+
+// Temporary file first, synced, then renamed: readers see the old index or the new one
+static bool writeIndex(const Leaderboard *board)
+{
+    const LeaderboardTop &top = board->top;
+    unsigned char bytes[INDEX_HEADER_SIZE + (LEADERBOARD_TOP_COUNT + 1)*INDEX_ENTRY_SIZE + 4] = { 0 };
+    size_t size = INDEX_HEADER_SIZE;
+
+    memcpy(bytes, indexMagic, 4);
+    putU32(bytes + 4, LEADERBOARD_FORMAT_VERSION);
+    putU32(bytes + 8, (uint32_t)top.count);
+    putU64(bytes + 16, top.runCount);
+
+    encodeEntry(bytes + size, top.longest);
+    size += INDEX_ENTRY_SIZE;
+    for (int i = 0; i < top.count; i++, size += INDEX_ENTRY_SIZE) encodeEntry(bytes + size, top.entries[i]);
+
+    putU32(bytes + size, getChecksum(bytes, size));
+    size += 4;
+
+    char tempFileName[LEADERBOARD_MAX_FILENAME + 4];
+    snprintf(tempFileName, sizeof(tempFileName), "%s.tmp", board->indexFileName);
+
+    FILE *file = fopen(tempFileName, "wb");
+    if (file == NULL) return false;
+
+    bool success = (fwrite(bytes, 1, size, file) == size);
+    success = syncFile(file) && success;
+    success = (fclose(file) == 0) && success;
+
+    std::error_code error;
+    if (success) std::filesystem::rename(tempFileName, board->indexFileName, error);
+    if (!success || error) remove(tempFileName);
+
+    return success && !error;
+}
+
+static bool readIndex(const char *fileName, LeaderboardTop *top)
+{
+    unsigned char bytes[INDEX_HEADER_SIZE + (LEADERBOARD_TOP_COUNT + 1)*INDEX_ENTRY_SIZE + 4];
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+
+    size_t size = fread(bytes, 1, sizeof(bytes), file);
+    fclose(file);
+
+    if ((size < INDEX_HEADER_SIZE + INDEX_ENTRY_SIZE + 4) || (memcmp(bytes, indexMagic, 4) != 0)) return false;
+    if (getU32(bytes + 4) != LEADERBOARD_FORMAT_VERSION) return false;
+
+    uint32_t count = getU32(bytes + 8);
+    if ((count > LEADERBOARD_TOP_COUNT) || (size != INDEX_HEADER_SIZE + (count + 1)*INDEX_ENTRY_SIZE + 4)) return false;
+    if (getU32(bytes + size - 4) != getChecksum(bytes, size - 4)) return false;
+
+    top->count = (int)count;
+    top->runCount = getU64(bytes + 16);
+    top->longest = decodeEntry(bytes + INDEX_HEADER_SIZE);
+    for (int i = 0; i < top->count; i++) top->entries[i] = decodeEntry(bytes + INDEX_HEADER_SIZE + (i + 1)*INDEX_ENTRY_SIZE);
+
+    return true;
+}
+
+// Checks the header and cuts a torn last record, returns the complete record count or -1
+static int64_t checkRunsFile(const char *fileName)
+{
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(fileName, error);
+    if (error) return 0;        // No runs yet
+
+    // Crash while the first append wrote the header, nothing was recorded
+    if (size < RUNS_HEADER_SIZE)
+    {
+        std::filesystem::resize_file(fileName, 0, error);
+        return error? -1 : 0;
+    }
+
+    unsigned char header[RUNS_HEADER_SIZE] = { 0 };
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return -1;
+
+    size_t headerSize = fread(header, 1, RUNS_HEADER_SIZE, file);
+    fclose(file);
+
+    if ((headerSize != RUNS_HEADER_SIZE) || (memcmp(header, runsMagic, 4) != 0)) return -1;
+    if ((getU32(header + 4) != LEADERBOARD_FORMAT_VERSION) || (getU32(header + 8) != RUN_RECORD_SIZE)) return -1;
+
+    uint64_t count = (size - RUNS_HEADER_SIZE)/RUN_RECORD_SIZE;
+    uint64_t alignedSize = RUNS_HEADER_SIZE + count*RUN_RECORD_SIZE;
+
+    if (alignedSize != size)
+    {
+        std::filesystem::resize_file(fileName, alignedSize, error);
+        if (error) return -1;
+    }
+
+    return (int64_t)count;
+}
+
+// Ranks the records in [first, count) of the mapped log
+static bool foldRuns(Leaderboard *board, uint64_t first, uint64_t count)
+{
+    LeaderboardView view = { 0 };
+    if (!MapLeaderboardRuns(&view, board->runsFileName) || (view.count < count))
+    {
+        UnmapLeaderboardRuns(&view);
+        return false;
+    }
+
+    LeaderboardRun run = { 0 };
+
+    for (uint64_t i = first; i < count; i++)
+    {
+        if (GetLeaderboardViewRun(&view, i, &run)) AddLeaderboardEntry(&board->top, { run.score, run.ticks, run.date, i });
+    }
+
+    board->top.runCount = count;
+    UnmapLeaderboardRuns(&view);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Leaderboard Functions Definition
+//----------------------------------------------------------------------------------
+bool OpenLeaderboard(Leaderboard *board, const char *baseFileName)
+{
+    snprintf(board->runsFileName, LEADERBOARD_MAX_FILENAME, "%s.runs", baseFileName);
+    snprintf(board->indexFileName, LEADERBOARD_MAX_FILENAME, "%s.index", baseFileName);
+    board->top = { 0 };
+
+    int64_t runCount = checkRunsFile(board->runsFileName);
+    if (runCount < 0) return false;
+
+    // An index ahead of the log belongs to some other log, start over
+    bool isIndexValid = readIndex(board->indexFileName, &board->top) && (board->top.runCount <= (uint64_t)runCount);
+    if (!isIndexValid) board->top = { 0 };
+
+    if (board->top.runCount == (uint64_t)runCount) return true;
+    if (!foldRuns(board, board->top.runCount, (uint64_t)runCount)) return false;
+
+    return writeIndex(board);
+}
+
+bool AppendLeaderboardRuns(Leaderboard *board, const LeaderboardRun *runs, int count)
+{
+    // ftell() is not reliable before the first write in append mode, ask the filesystem
+    std::error_code error;
+    bool isNewFile = (std::filesystem::file_size(board->runsFileName, error) == 0) || error;
+
+    FILE *file = fopen(board->runsFileName, "ab");
+    if (file == NULL) return false;
+
+    bool success = true;
+
+    if (isNewFile)
+    {
+        unsigned char header[RUNS_HEADER_SIZE] = { 0 };
+        memcpy(header, runsMagic, 4);
+        putU32(header + 4, LEADERBOARD_FORMAT_VERSION);
+        putU32(header + 8, RUN_RECORD_SIZE);
+        success = (fwrite(header, 1, RUNS_HEADER_SIZE, file) == RUNS_HEADER_SIZE);
+    }
+
+    unsigned char bytes[APPEND_BATCH_RUNS*RUN_RECORD_SIZE];
+
+    for (int first = 0; (first < count) && success; first += APPEND_BATCH_RUNS)
+    {
+        int batchCount = (count - first < APPEND_BATCH_RUNS)? count - first : APPEND_BATCH_RUNS;
+
+        for (int i = 0; i < batchCount; i++) encodeRun(bytes + i*RUN_RECORD_SIZE, runs[first + i]);
+        success = (fwrite(bytes, RUN_RECORD_SIZE, batchCount, file) == (size_t)batchCount);
+    }
+
+    success = syncFile(file) && success;
+    success = (fclose(file) == 0) && success;
+
+    // A failed append may have left a partial record, the next open cuts it
+    if (!success) return false;
+
+    for (int i = 0; i < count; i++)
+    {
+        AddLeaderboardEntry(&board->top, { runs[i].score, runs[i].ticks, runs[i].date, board->top.runCount });
+        board->top.runCount++;
+    }
+
+    return writeIndex(board);
+}
+
+int AddLeaderboardEntry(LeaderboardTop *top, LeaderboardEntry entry)
+{
+    if (entry.ticks > top->longest.ticks) top->longest = entry;
+
+    // Most runs do not make it, one comparison against the last entry settles them
+    if ((top->count == LEADERBOARD_TOP_COUNT) && !isEntryAhead(entry, top->entries[top->count - 1])) return -1;
+
+    int rank = (top->count < LEADERBOARD_TOP_COUNT)? top->count : LEADERBOARD_TOP_COUNT - 1;
+    while ((rank > 0) && isEntryAhead(entry, top->entries[rank - 1]))
+    {
+        top->entries[rank] = top->entries[rank - 1];
+        rank--;
+    }
+
+    top->entries[rank] = entry;
+    if (top->count < LEADERBOARD_TOP_COUNT) top->count++;
+
+    return rank;
+}
+
+bool MapLeaderboardRuns(LeaderboardView *view, const char *runsFileName)
+{
+    *view = { 0 };
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(runsFileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size = { 0 };
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && (size.QuadPart > RUNS_HEADER_SIZE)) mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);      // The mapping keeps the file open
+    if (mapping == NULL) return false;
+
+    view->data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view->data == NULL)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    view->handle = mapping;
+    view->size = (size_t)size.QuadPart;
+#else
+    int file = open(runsFileName, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat status = { 0 };
+    void *data = MAP_FAILED;
+    if ((fstat(file, &status) == 0) && (status.st_size > RUNS_HEADER_SIZE)) data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);            // The mapping keeps the file open
+    if (data == MAP_FAILED) return false;
+
+    view->data = (const unsigned char *)data;
+    view->size = (size_t)status.st_size;
+#endif
+
+    if ((memcmp(view->data, runsMagic, 4) != 0) || (getU32(view->data + 8) != RUN_RECORD_SIZE))
+    {
+        UnmapLeaderboardRuns(view);
+        return false;
+    }
+
+    view->count = (view->size - RUNS_HEADER_SIZE)/RUN_RECORD_SIZE;
+
+    return true;
+}
+
+void UnmapLeaderboardRuns(LeaderboardView *view)
+{
+    if (view->data != NULL)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(view->data);
+        CloseHandle((HANDLE)view->handle);
+#else
+        munmap((void *)view->data, view->size);
+#endif
+    }
+
+    *view = { 0 };
+}
+
+bool GetLeaderboardViewRun(const LeaderboardView *view, uint64_t index, LeaderboardRun *run)
+{
+    if (index >= view->count) return false;
+
+    const unsigned char *bytes = view->data + RUNS_HEADER_SIZE + index*RUN_RECORD_SIZE;
+    if (getU32(bytes + 28) != getChecksum(bytes, RUN_RECORD_SIZE - 4)) return false;
+
+    run->score = (int)getU32(bytes);
+    run->ticks = getU32(bytes + 4);
+    run->seed = getU64(bytes + 8);
+    run->date = (int64_t)getU64(bytes + 16);
+    run->flags = getU32(bytes + 24);
+
+    return true;
+}
@@ -0,0 +1,167 @@
+/**********************************************************************************************
+*
+*   Movement Kernel - Batched move and screen wrap for entity arrays
+*
+**********************************************************************************************/
+
+#include "movement_kernel.h"
+#include <math.h>           // Required for: cosf(), sinf()
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define MOVEMENT_KERNEL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define MOVEMENT_KERNEL_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define MOVEMENT_KERNEL_NEON
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Scalar version, also used for the tail of the SIMD loops
+static void MoveAndWrapScalar(float *positionX, float *positionY, const float *velocityX, const float *velocityY,
+                              Rectangle *bounds, int first, int count, float worldWidth, float worldHeight)
+{
+    for (int i = first; i < count; i++)
+    {
+        float x = positionX[i] + velocityX[i];
+        float y = positionY[i] + velocityY[i];
+
+        // Hitbox follows the position before wrapping
+        bounds[i].x = x;
+        bounds[i].y = y;
+
+        // Moves outside the screen make the object appear through the other side
+        if (x < 0) x += worldWidth;
+        if (y < 0) y += worldHeight;
+        if (x > worldWidth) x -= worldWidth;
+        if (y > worldHeight) y -= worldHeight;
+
+        positionX[i] = x;
+        positionY[i] = y;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Movement Kernel Functions Definition
+//----------------------------------------------------------------------------------
+
+// NOTE: Same expression the per-frame movement used, so cached velocities stay bit-identical
+Vector2 GetHeadingVector(float rotationDegrees, float speed)
+{
+    float radians = rotationDegrees*PI/180;
+
+    return { speed*cosf(radians), speed*sinf(radians) };
+}
+
+const char *GetMovementKernelName(void)
+{
+#if defined(MOVEMENT_KERNEL_AVX2)
+    return "AVX2";
+#elif defined(MOVEMENT_KERNEL_SSE2)
+    return "SSE2";
+#elif defined(MOVEMENT_KERNEL_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+// NOTE: Wrapping selects between the moved and the wrapped value instead of adding a masked
+// offset, so negative zero and every other input keep the exact scalar result
+void MoveAndWrapEntities(float *positionX, float *positionY, const float *velocityX, const float *velocityY,
+                         Rectangle *bounds, int count, float worldWidth, float worldHeight)
+{
+    int i = 0;
+
+#if defined(MOVEMENT_KERNEL_AVX2)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 width = _mm256_set1_ps(worldWidth);
+    const __m256 height = _mm256_set1_ps(worldHeight);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(positionX + i), _mm256_loadu_ps(velocityX + i));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(positionY + i), _mm256_loadu_ps(velocityY + i));
+
+        // Interleave into (x, y) pairs to fill the hitbox origins
+        __m256 low = _mm256_unpacklo_ps(x, y);      // x0 y0 x1 y1 | x4 y4 x5 y5
+        __m256 high = _mm256_unpackhi_ps(x, y);     // x2 y2 x3 y3 | x6 y6 x7 y7
+        __m128 pairs[4] = { _mm256_castps256_ps128(low), _mm256_castps256_ps128(high), _mm256_extractf128_ps(low, 1), _mm256_extractf128_ps(high, 1) };
+
+        for (int k = 0; k < 4; k++)
+        {
+            _mm_storel_pi((__m64 *)&bounds[i + k*2].x, pairs[k]);
+            _mm_storeh_pi((__m64 *)&bounds[i + k*2 + 1].x, pairs[k]);
+        }
+
+        x = _mm256_blendv_ps(x, _mm256_add_ps(x, width), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+        y = _mm256_blendv_ps(y, _mm256_add_ps(y, height), _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+        x = _mm256_blendv_ps(x, _mm256_sub_ps(x, width), _mm256_cmp_ps(x, width, _CMP_GT_OQ));
+        y = _mm256_blendv_ps(y, _mm256_sub_ps(y, height), _mm256_cmp_ps(y, height, _CMP_GT_OQ));
+
+        _mm256_storeu_ps(positionX + i, x);
+        _mm256_storeu_ps(positionY + i, y);
+    }
+#elif defined(MOVEMENT_KERNEL_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 width = _mm_set1_ps(worldWidth);
+    const __m128 height = _mm_set1_ps(worldHeight);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_loadu_ps(velocityX + i));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_loadu_ps(velocityY + i));
+
+        __m128 low = _mm_unpacklo_ps(x, y);         // x0 y0 x1 y1
+        __m128 high = _mm_unpackhi_ps(x, y);        // x2 y2 x3 y3
+        _mm_storel_pi((__m64 *)&bounds[i].x, low);
+        _mm_storeh_pi((__m64 *)&bounds[i + 1].x, low);
+        _mm_storel_pi((__m64 *)&bounds[i + 2].x, high);
+        _mm_storeh_pi((__m64 *)&bounds[i + 3].x, high);
+
+        // SSE2 has no blend instruction, select with and/andnot/or
+        __m128 mask = _mm_cmplt_ps(x, zero);
+        x = _mm_or_ps(_mm_and_ps(mask, _mm_add_ps(x, width)), _mm_andnot_ps(mask, x));
+        mask = _mm_cmplt_ps(y, zero);
+        y = _mm_or_ps(_mm_and_ps(mask, _mm_add_ps(y, height)), _mm_andnot_ps(mask, y));
+        mask = _mm_cmpgt_ps(x, width);
+        x = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(x, width)), _mm_andnot_ps(mask, x));
+        mask = _mm_cmpgt_ps(y, height);
+        y = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(y, height)), _mm_andnot_ps(mask, y));
+
+        _mm_storeu_ps(positionX + i, x);
+        _mm_storeu_ps(positionY + i, y);
+    }
+#elif defined(MOVEMENT_KERNEL_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t width = vdupq_n_f32(worldWidth);
+    const float32x4_t height = vdupq_n_f32(worldHeight);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t x = vaddq_f32(vld1q_f32(positionX + i), vld1q_f32(velocityX + i));
+        float32x4_t y = vaddq_f32(vld1q_f32(positionY + i), vld1q_f32(velocityY + i));
+
+        float32x4x2_t pairs = vzipq_f32(x, y);      // x0 y0 x1 y1 | x2 y2 x3 y3
+        vst1_f32(&bounds[i].x, vget_low_f32(pairs.val[0]));
+        vst1_f32(&bounds[i + 1].x, vget_high_f32(pairs.val[0]));
+        vst1_f32(&bounds[i + 2].x, vget_low_f32(pairs.val[1]));
+        vst1_f32(&bounds[i + 3].x, vget_high_f32(pairs.val[1]));
+
+        x = vbslq_f32(vcltq_f32(x, zero), vaddq_f32(x, width), x);
+        y = vbslq_f32(vcltq_f32(y, zero), vaddq_f32(y, height), y);
+        x = vbslq_f32(vcgtq_f32(x, width), vsubq_f32(x, width), x);
+        y = vbslq_f32(vcgtq_f32(y, height), vsubq_f32(y, height), y);
+
+        vst1q_f32(positionX + i, x);
+        vst1q_f32(positionY + i, y);
+    }
+#endif
+
+    MoveAndWrapScalar(positionX, positionY, velocityX, velocityY, bounds, i, count, worldWidth, worldHeight);
+}
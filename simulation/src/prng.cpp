@@ -0,0 +1,39 @@
+/**********************************************************************************************
+*
+*   PRNG - Small seedable random generator (PCG32, XSH RR variant)
+*
+**********************************************************************************************/
+
+#include "prng.h"
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void SeedPrng(Prng *rng, uint64_t seed)
+{
+    // Stream derived from the seed too, so nearby seeds do not produce shifted copies
+    rng->state = 0;
+    rng->increment = (seed << 1) | 1u;
+    GetPrngNext(rng);
+    rng->state += seed;
+    GetPrngNext(rng);
+}
+
+uint32_t GetPrngNext(Prng *rng)
+{
+    uint64_t oldState = rng->state;
+    rng->state = oldState*PCG_MULTIPLIER + rng->increment;
+
+    uint32_t xorShifted = (uint32_t)(((oldState >> 18u) ^ oldState) >> 27u);
+    uint32_t rotation = (uint32_t)(oldState >> 59u);
+
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+}
+
+int GetPrngBounded(Prng *rng, int bound)
+{
+    // Multiply-shift instead of modulo: no division and no low-bit bias of rand() % n
+    return (int)(((uint64_t)GetPrngNext(rng)*(uint32_t)bound) >> 32);
+}
@@ -0,0 +1,191 @@
+/**********************************************************************************************
+*
+*   Profiler - Scoped phase timers recorded into a lock-free ring buffer
+*
+**********************************************************************************************/
+
+#include "profiler.h"
+
+#if defined(ENABLE_PROFILER)
+
+#include <stdio.h>
+#include <string.h>                 // Required for: strcmp()
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ProfileEvent {
+    std::atomic<uint32_t> sequence;     // Claimed index + 1, stored last so readers skip half written slots
+    const char *name;
+    uint64_t startTime;
+    uint64_t endTime;
+    uint32_t frame;
+    uint32_t thread;
+} ProfileEvent;
+
+// Scratch entry for percentile sorting
+typedef struct PhaseSample {
+    int phase;
+    float duration;
+} PhaseSample;
+
+//----------------------------------------------------------------------------------
+// Module Variables Definition (local)
+//----------------------------------------------------------------------------------
+static ProfileEvent ring[PROFILER_RING_CAPACITY];
+static std::atomic<uint32_t> writeIndex(0);
+static std::atomic<uint32_t> frameIndex(0);
+static std::atomic<uint32_t> threadCount(0);
+static thread_local uint32_t threadId = threadCount++;
+
+static PhaseSample samples[PROFILER_RING_CAPACITY];     // Main thread only, keeps stats allocation free
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Calls fn(event) for each complete event still in the ring, oldest first
+template <typename Function>
+static void forEachEvent(Function fn)
+{
+    uint32_t end = writeIndex.load(std::memory_order_acquire);
+    uint32_t begin = (end > PROFILER_RING_CAPACITY)? end - PROFILER_RING_CAPACITY : 0;
+
+    for (uint32_t index = begin; index < end; index++)
+    {
+        const ProfileEvent &event = ring[index & (PROFILER_RING_CAPACITY - 1)];
+        if (event.sequence.load(std::memory_order_acquire) == index + 1) fn(event);
+    }
+}
+
+static float getPercentile(const PhaseSample *sorted, int count, float percentile)
+{
+    int index = (int)(percentile*(count - 1) + 0.5f);
+    return sorted[index].duration;
+}
+
+//----------------------------------------------------------------------------------
+// Profiler Functions Definition
+//----------------------------------------------------------------------------------
+uint64_t GetProfileTime(void)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RecordProfileEvent(const char *name, uint64_t startTime, uint64_t endTime)
+{
+    uint32_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    ProfileEvent &event = ring[index & (PROFILER_RING_CAPACITY - 1)];
+
+    event.sequence.store(0, std::memory_order_relaxed);
+    event.name = name;
+    event.startTime = startTime;
+    event.endTime = endTime;
+    event.frame = frameIndex.load(std::memory_order_relaxed);
+    event.thread = threadId;
+    event.sequence.store(index + 1, std::memory_order_release);
+}
+
+void MarkProfileFrame(void)
+{
+    frameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+int GetProfileStats(ProfileStats *stats, int maxStats, int lastFrames)
+{
+    uint32_t currentFrame = frameIndex.load(std::memory_order_relaxed);
+    uint32_t firstFrame = (currentFrame > (uint32_t)lastFrames)? currentFrame - lastFrames : 0;
+    const char *names[PROFILER_MAX_PHASES] = { 0 };
+    int phaseCount = 0;
+    int sampleCount = 0;
+
+    forEachEvent([&](const ProfileEvent &event)
+    {
+        if ((event.frame < firstFrame) || (event.frame >= currentFrame)) return;
+
+        // Same literal usually means same pointer, strcmp covers literals duplicated across modules
+        int phase = 0;
+        while ((phase < phaseCount) && (names[phase] != event.name) && (strcmp(names[phase], event.name) != 0)) phase++;
+
+        if (phase == phaseCount)
+        {
+            if (phaseCount == PROFILER_MAX_PHASES) return;
+            names[phaseCount++] = event.name;
+        }
+
+        samples[sampleCount].phase = phase;
+        samples[sampleCount].duration = (float)(event.endTime - event.startTime)/1000.0f;
+        sampleCount++;
+    });
+
+    std::sort(samples, samples + sampleCount, [](const PhaseSample &a, const PhaseSample &b)
+    {
+        return (a.phase != b.phase)? (a.phase < b.phase) : (a.duration < b.duration);
+    });
+
+    int written = 0;
+    for (int begin = 0; (begin < sampleCount) && (written < maxStats); )
+    {
+        int end = begin;
+        while ((end < sampleCount) && (samples[end].phase == samples[begin].phase)) end++;
+
+        ProfileStats &phaseStats = stats[written++];
+        phaseStats.name = names[samples[begin].phase];
+        phaseStats.samples = end - begin;
+        phaseStats.p50 = getPercentile(samples + begin, end - begin, 0.50f);
+        phaseStats.p95 = getPercentile(samples + begin, end - begin, 0.95f);
+        phaseStats.p99 = getPercentile(samples + begin, end - begin, 0.99f);
+        phaseStats.max = samples[end - 1].duration;
+
+        begin = end;
+    }
+
+    std::sort(stats, stats + written, [](const ProfileStats &a, const ProfileStats &b) { return a.p50 > b.p50; });
+
+    return written;
+}
+
+bool ExportProfileCsv(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "frame,thread,phase,start_us,duration_us\n");
+
+    forEachEvent([&](const ProfileEvent &event)
+    {
+        fprintf(file, "%u,%u,%s,%.3f,%.3f\n", event.frame, event.thread, event.name, event.startTime/1000.0, (event.endTime - event.startTime)/1000.0);
+    });
+
+    fclose(file);
+
+    return true;
+}
+
+bool ExportProfileChromeTrace(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    bool isFirst = true;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    forEachEvent([&](const ProfileEvent &event)
+    {
+        // Complete events ("X"), timestamps in microseconds
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}",
+                isFirst? "" : ",\n", event.name, event.thread, event.startTime/1000.0, (event.endTime - event.startTime)/1000.0, event.frame);
+        isFirst = false;
+    });
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+
+    return true;
+}
+
+#endif // ENABLE_PROFILER
@@ -0,0 +1,244 @@
+/**********************************************************************************************
+*
+*   Replay - Append-only input recording for deterministic playback
+*
+**********************************************************************************************/
+
+#include "replay.h"
+#include <string.h>                 // Required for: memcpy(), memcmp()
+#include <limits.h>                 // Required for: INT_MAX
+
+static const char replayMagic[4] = { 'A', 'S', 'R', 'P' };
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Fixed byte order so replays move between machines
+static void writeU32(FILE *file, uint32_t value)
+{
+    unsigned char bytes[4] = { (unsigned char)value, (unsigned char)(value >> 8), (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+    fwrite(bytes, 1, 4, file);
+}
+
+static void writeU64(FILE *file, uint64_t value)
+{
+    writeU32(file, (uint32_t)value);
+    writeU32(file, (uint32_t)(value >> 32));
+}
+
+static void writeF32(FILE *file, float value)
+{
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    writeU32(file, bits);
+}
+
+static bool readU32(FILE *file, uint32_t *value)
+{
+    unsigned char bytes[4] = { 0 };
+    if (fread(bytes, 1, 4, file) != 4) return false;
+
+    *value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    return true;
+}
+
+static bool readU64(FILE *file, uint64_t *value)
+{
+    uint32_t low = 0;
+    uint32_t high = 0;
+    if (!readU32(file, &low) || !readU32(file, &high)) return false;
+
+    *value = (uint64_t)low | ((uint64_t)high << 32);
+    return true;
+}
+
+static bool readI32(FILE *file, int *value)
+{
+    uint32_t bits = 0;
+    if (!readU32(file, &bits)) return false;
+
+    *value = (int)bits;
+    return true;
+}
+
+static bool readF32(FILE *file, float *value)
+{
+    uint32_t bits = 0;
+    if (!readU32(file, &bits)) return false;
+
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+// Only the hull is stored, normals and radius are derived again when reading
+static void writeShape(FILE *file, const CollisionShape *shape)
+{
+    writeU32(file, (uint32_t)shape->vertexCount);
+    for (int i = 0; i < shape->vertexCount; i++)
+    {
+        writeF32(file, shape->vertices[i].x);
+        writeF32(file, shape->vertices[i].y);
+    }
+}
+
+static bool readShape(FILE *file, CollisionShape *shape)
+{
+    uint32_t vertexCount = 0;
+    Vector2 vertices[COLLISION_SHAPE_MAX_VERTICES] = { 0 };
+
+    if (!readU32(file, &vertexCount) || (vertexCount < 3) || (vertexCount > COLLISION_SHAPE_MAX_VERTICES)) return false;
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        if (!readF32(file, &vertices[i].x) || !readF32(file, &vertices[i].y)) return false;
+    }
+
+    *shape = GenCollisionShapeFromPoints(vertices, (int)vertexCount);
+    return true;
+}
+
+// Bits 0-1 rotation + 1, bits 2-3 thrust + 1, bit 4 shoot, bit 5 quit
+static unsigned char encodeInput(SimInput input)
+{
+    return (unsigned char)((input.rotation + 1) | ((input.thrust + 1) << 2) | (input.shoot << 4) | (input.quit << 5));
+}
+
+static SimInput decodeInput(unsigned char bits)
+{
+    SimInput input = { 0 };
+
+    input.rotation = (bits & 0x03) - 1;
+    input.thrust = ((bits >> 2) & 0x03) - 1;
+    input.shoot = (bits >> 4) & 1;
+    input.quit = (bits >> 5) & 1;
+
+    return input;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool OpenReplayWriter(ReplayWriter *writer, const char *fileName, uint64_t seed, const SimConfig *config)
+{
+    writer->frames = 0;
+    writer->file = fopen(fileName, "wb");
+    if (writer->file == NULL) return false;
+
+    fwrite(replayMagic, 1, sizeof(replayMagic), writer->file);
+    writeU32(writer->file, REPLAY_FORMAT_VERSION);
+    writeU64(writer->file, seed);
+
+    writeF32(writer->file, config->worldWidth);
+    writeF32(writer->file, config->worldHeight);
+    writeF32(writer->file, config->playerSize.x);
+    writeF32(writer->file, config->playerSize.y);
+    for (int size = 1; size < 4; size++)
+    {
+        writeF32(writer->file, config->asteroidSizes[size].x);
+        writeF32(writer->file, config->asteroidSizes[size].y);
+    }
+    writeF32(writer->file, config->powerUpSize.x);
+    writeF32(writer->file, config->powerUpSize.y);
+    writeU32(writer->file, (uint32_t)config->asteroidCapacity);
+    writeU32(writer->file, (uint32_t)config->shotCapacity);
+
+    writeF32(writer->file, config->asteroidSpeed);
+    writeF32(writer->file, config->shotSpeed);
+    writeF32(writer->file, config->shotSize);
+    writeU32(writer->file, (uint32_t)config->shotFramesLifespan);
+    writeU32(writer->file, (uint32_t)config->playerShotCooldownFrames);
+    writeU32(writer->file, (uint32_t)config->playerInvencibilityFrames);
+    writeU32(writer->file, (uint32_t)config->playerPowerUpLifespan);
+    writeU32(writer->file, (uint32_t)config->powerUpFramesLifespan);
+    writeU32(writer->file, (uint32_t)config->powerUpGenerationRate);
+    writeU32(writer->file, (uint32_t)config->powerUpShotCount);
+    writeU32(writer->file, (uint32_t)config->multipleShotDeviationDegrees);
+    writeU32(writer->file, (uint32_t)config->stressAsteroidCount);
+
+    writeShape(writer->file, &config->playerShape);
+    for (int size = 1; size < 4; size++) writeShape(writer->file, &config->asteroidShapes[size]);
+
+    return true;
+}
+
+void WriteReplayFrame(ReplayWriter *writer, SimInput input, uint32_t stateHash)
+{
+    if (writer->file == NULL) return;
+
+    fputc(encodeInput(input), writer->file);
+    writeU32(writer->file, stateHash);
+    writer->frames++;
+}
+
+void CloseReplayWriter(ReplayWriter *writer)
+{
+    if (writer->file != NULL) fclose(writer->file);
+    writer->file = NULL;
+}
+
+bool OpenReplayReader(ReplayReader *reader, const char *fileName)
+{
+    reader->frames = 0;
+    reader->config = GetDefaultSimConfig();
+    reader->file = fopen(fileName, "rb");
+    if (reader->file == NULL) return false;
+
+    char magic[4] = { 0 };
+    uint32_t version = 0;
+    uint32_t asteroidCapacity = 0;
+    uint32_t shotCapacity = 0;
+    SimConfig *config = &reader->config;
+
+    bool valid = (fread(magic, 1, sizeof(magic), reader->file) == sizeof(magic)) && (memcmp(magic, replayMagic, sizeof(magic)) == 0);
+    valid = valid && readU32(reader->file, &version) && (version == REPLAY_FORMAT_VERSION);
+    valid = valid && readU64(reader->file, &reader->seed);
+
+    valid = valid && readF32(reader->file, &config->worldWidth) && readF32(reader->file, &config->worldHeight);
+    valid = valid && readF32(reader->file, &config->playerSize.x) && readF32(reader->file, &config->playerSize.y);
+    for (int size = 1; size < 4; size++)
+    {
+        valid = valid && readF32(reader->file, &config->asteroidSizes[size].x) && readF32(reader->file, &config->asteroidSizes[size].y);
+    }
+    valid = valid && readF32(reader->file, &config->powerUpSize.x) && readF32(reader->file, &config->powerUpSize.y);
+    valid = valid && readU32(reader->file, &asteroidCapacity) && readU32(reader->file, &shotCapacity);
+
+    config->asteroidCapacity = (int)asteroidCapacity;
+    config->shotCapacity = (int)shotCapacity;
+
+    valid = valid && readF32(reader->file, &config->asteroidSpeed) && readF32(reader->file, &config->shotSpeed) && readF32(reader->file, &config->shotSize);
+    valid = valid && readI32(reader->file, &config->shotFramesLifespan) && readI32(reader->file, &config->playerShotCooldownFrames);
+    valid = valid && readI32(reader->file, &config->playerInvencibilityFrames) && readI32(reader->file, &config->playerPowerUpLifespan);
+    valid = valid && readI32(reader->file, &config->powerUpFramesLifespan) && readI32(reader->file, &config->powerUpGenerationRate);
+    valid = valid && readI32(reader->file, &config->powerUpShotCount) && readI32(reader->file, &config->multipleShotDeviationDegrees);
+    valid = valid && readI32(reader->file, &config->stressAsteroidCount);
+
+    valid = valid && readShape(reader->file, &config->playerShape);
+    for (int size = 1; size < 4; size++) valid = valid && readShape(reader->file, &config->asteroidShapes[size]);
+
+    // Pools and the grid are sized from the header, out of range values never reach InitSimulation()
+    valid = valid && (asteroidCapacity <= INT_MAX) && (shotCapacity <= INT_MAX) && IsSimConfigValid(config);
+
+    if (!valid) CloseReplayReader(reader);
+
+    return valid;
+}
+
+bool ReadReplayFrame(ReplayReader *reader, SimInput *input, uint32_t *stateHash)
+{
+    if (reader->file == NULL) return false;
+
+    int bits = fgetc(reader->file);
+    if ((bits == EOF) || !readU32(reader->file, stateHash)) return false;
+
+    *input = decodeInput((unsigned char)bits);
+    reader->frames++;
+
+    return true;
+}
+
+void CloseReplayReader(ReplayReader *reader)
+{
+    if (reader->file != NULL) fclose(reader->file);
+    reader->file = NULL;
+}
@@ -0,0 +1,202 @@
+/**********************************************************************************************
+*
+*   Sim Snapshot - Flat copies of a GameState for restart, rewind and checkpoints
+*
+**********************************************************************************************/
+
+#include "sim_snapshot.h"
+#include <string.h>                 // Required for: memcpy(), memset()
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct SimSnapshotHeader {
+    unsigned int version;
+    int size;                       // Whole snapshot, checked on load
+    SimConfig config;
+    uint64_t seed;
+    Prng rng;
+    Player player;
+    PlayerPowerUp powerUp;
+    int framesCounter;
+    int isFinished;
+    int asteroidCount;              // Live and pending entities, then free slots, per pool
+    int asteroidPendingCount;
+    int asteroidFreeCount;
+    int shotCount;
+    int shotPendingCount;
+    int shotFreeCount;
+} SimSnapshotHeader;
+
+#define ASTEROID_FIELD_BYTES (5*sizeof(float) + sizeof(Rectangle) + 2*sizeof(unsigned char))
+#define SHOT_FIELD_BYTES (5*sizeof(float) + sizeof(Rectangle) + sizeof(int) + sizeof(unsigned char))
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+template <typename T>
+static void writeArray(unsigned char **cursor, const std::vector<T> &values, int count)
+{
+    memcpy(*cursor, values.data(), count*sizeof(T));
+    *cursor += count*sizeof(T);
+}
+
+template <typename T>
+static void readArray(const unsigned char **cursor, std::vector<T> &values, int count)
+{
+    memcpy(values.data(), *cursor, count*sizeof(T));
+    *cursor += count*sizeof(T);
+}
+
+static void writeSlots(unsigned char **cursor, const EntitySlots &slots)
+{
+    writeArray(cursor, slots.generation, slots.capacity);
+    writeArray(cursor, slots.denseSlot, slots.count + slots.pendingCount);
+    writeArray(cursor, slots.freeSlots, slots.freeCount);
+}
+
+// The slot of every entity is stored, its reverse lookup is rebuilt
+static void readSlots(const unsigned char **cursor, EntitySlots *slots, int count, int pendingCount, int freeCount)
+{
+    slots->count = count;
+    slots->pendingCount = pendingCount;
+    slots->freeCount = freeCount;
+
+    readArray(cursor, slots->generation, slots->capacity);
+    readArray(cursor, slots->denseSlot, count + pendingCount);
+    readArray(cursor, slots->freeSlots, freeCount);
+
+    std::fill(slots->denseIndex.begin(), slots->denseIndex.end(), -1);
+    for (int i = 0; i < count + pendingCount; i++) slots->denseIndex[slots->denseSlot[i]] = i;
+}
+
+static int getSnapshotSize(const SimConfig *config, int asteroidCount, int shotCount)
+{
+    // Every slot is either used (denseSlot) or free (freeSlots), so both lists add up to the capacity
+    return (int)(sizeof(SimSnapshotHeader) + config->asteroidCapacity*2*sizeof(int) + asteroidCount*ASTEROID_FIELD_BYTES +
+                 config->shotCapacity*2*sizeof(int) + shotCount*SHOT_FIELD_BYTES);
+}
+
+//----------------------------------------------------------------------------------
+// Sim Snapshot Functions Definition
+//----------------------------------------------------------------------------------
+int GetSimSnapshotMaxSize(const SimConfig *config)
+{
+    return getSnapshotSize(config, config->asteroidCapacity, config->shotCapacity);
+}
+
+void SaveSimSnapshot(const GameState *state, SimSnapshot *snapshot)
+{
+    const AsteroidStore &asteroids = state->asteroids;
+    const ShotStore &shots = state->shots;
+    int asteroidCount = asteroids.slots.count + asteroids.slots.pendingCount;
+    int shotCount = shots.slots.count + shots.slots.pendingCount;
+
+    int maxSize = GetSimSnapshotMaxSize(&state->config);
+    if ((int)snapshot->data.size() < maxSize) snapshot->data.resize(maxSize);
+
+    SimSnapshotHeader header;
+    memset(&header, 0, sizeof(header));     // Padding too, equal states give equal bytes
+    header.version = SIM_SNAPSHOT_VERSION;
+    header.size = getSnapshotSize(&state->config, asteroidCount, shotCount);
+    header.config = state->config;
+    header.seed = state->seed;
+    header.rng = state->rng;
+    header.player = state->player;
+    header.powerUp = state->powerUp;
+    header.framesCounter = state->framesCounter;
+    header.isFinished = state->isFinished;
+    header.asteroidCount = asteroids.slots.count;
+    header.asteroidPendingCount = asteroids.slots.pendingCount;
+    header.asteroidFreeCount = asteroids.slots.freeCount;
+    header.shotCount = shots.slots.count;
+    header.shotPendingCount = shots.slots.pendingCount;
+    header.shotFreeCount = shots.slots.freeCount;
+
+    unsigned char *cursor = snapshot->data.data();
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    writeSlots(&cursor, asteroids.slots);
+    writeArray(&cursor, asteroids.positionX, asteroidCount);
+    writeArray(&cursor, asteroids.positionY, asteroidCount);
+    writeArray(&cursor, asteroids.rotationDegrees, asteroidCount);
+    writeArray(&cursor, asteroids.velocityX, asteroidCount);
+    writeArray(&cursor, asteroids.velocityY, asteroidCount);
+    writeArray(&cursor, asteroids.bounds, asteroidCount);
+    writeArray(&cursor, asteroids.size, asteroidCount);
+    writeArray(&cursor, asteroids.isActive, asteroidCount);
+
+    writeSlots(&cursor, shots.slots);
+    writeArray(&cursor, shots.positionX, shotCount);
+    writeArray(&cursor, shots.positionY, shotCount);
+    writeArray(&cursor, shots.rotationDegrees, shotCount);
+    writeArray(&cursor, shots.velocityX, shotCount);
+    writeArray(&cursor, shots.velocityY, shotCount);
+    writeArray(&cursor, shots.bounds, shotCount);
+    writeArray(&cursor, shots.framesLifespan, shotCount);
+    writeArray(&cursor, shots.isActive, shotCount);
+
+    snapshot->size = header.size;
+    snapshot->framesCounter = state->framesCounter;
+}
+
+bool LoadSimSnapshot(GameState *state, const unsigned char *data, int size)
+{
+    SimSnapshotHeader header;
+
+    if ((data == NULL) || (size < (int)sizeof(header))) return false;
+    memcpy(&header, data, sizeof(header));
+
+    // Pools and grid are sized from the capacities and the world, those can not change here
+    const SimConfig &config = header.config;
+    if ((header.version != SIM_SNAPSHOT_VERSION) || (header.size != size)) return false;
+    if ((config.asteroidCapacity != state->asteroids.slots.capacity) || (config.shotCapacity != state->shots.slots.capacity)) return false;
+    if ((config.worldWidth != state->config.worldWidth) || (config.worldHeight != state->config.worldHeight)) return false;
+    if (header.asteroidCount + header.asteroidPendingCount + header.asteroidFreeCount != config.asteroidCapacity) return false;
+    if (header.shotCount + header.shotPendingCount + header.shotFreeCount != config.shotCapacity) return false;
+
+    int asteroidCount = header.asteroidCount + header.asteroidPendingCount;
+    int shotCount = header.shotCount + header.shotPendingCount;
+    if (getSnapshotSize(&config, asteroidCount, shotCount) != size) return false;
+
+    state->config = config;
+    state->seed = header.seed;
+    state->rng = header.rng;
+    state->player = header.player;
+    state->powerUp = header.powerUp;
+    state->framesCounter = header.framesCounter;
+    state->isFinished = (header.isFinished != 0);
+    state->events = 0;
+    state->hits.clear();
+
+    state->maxAsteroidRadius = 0.0f;
+    for (int size = 1; size < 4; size++) state->maxAsteroidRadius = std::max(state->maxAsteroidRadius, config.asteroidShapes[size].radius);
+
+    AsteroidStore &asteroids = state->asteroids;
+    ShotStore &shots = state->shots;
+    const unsigned char *cursor = data + sizeof(header);
+
+    readSlots(&cursor, &asteroids.slots, header.asteroidCount, header.asteroidPendingCount, header.asteroidFreeCount);
+    readArray(&cursor, asteroids.positionX, asteroidCount);
+    readArray(&cursor, asteroids.positionY, asteroidCount);
+    readArray(&cursor, asteroids.rotationDegrees, asteroidCount);
+    readArray(&cursor, asteroids.velocityX, asteroidCount);
+    readArray(&cursor, asteroids.velocityY, asteroidCount);
+    readArray(&cursor, asteroids.bounds, asteroidCount);
+    readArray(&cursor, asteroids.size, asteroidCount);
+    readArray(&cursor, asteroids.isActive, asteroidCount);
+
+    readSlots(&cursor, &shots.slots, header.shotCount, header.shotPendingCount, header.shotFreeCount);
+    readArray(&cursor, shots.positionX, shotCount);
+    readArray(&cursor, shots.positionY, shotCount);
+    readArray(&cursor, shots.rotationDegrees, shotCount);
+    readArray(&cursor, shots.velocityX, shotCount);
+    readArray(&cursor, shots.velocityY, shotCount);
+    readArray(&cursor, shots.bounds, shotCount);
+    readArray(&cursor, shots.framesLifespan, shotCount);
+    readArray(&cursor, shots.isActive, shotCount);
+
+    return true;
+}
@@ -0,0 +1,776 @@
+/**********************************************************************************************
+*
+*   Simulation - Headless gameplay core for ASTEROIDS
+*
+*   Ported from the gameplay screen: rules, spawn rates and update order are unchanged,
+*   the only difference is that the game clock counts ticks instead of reading GetTime().
+*
+**********************************************************************************************/
+
+#include "simulation.h"
+#include "movement_kernel.h"
+#include "profiler.h"
+#include <stdio.h>                  // Required for: fprintf()
+#include <math.h>                   // Required for: fabsf(), INFINITY
+#include <algorithm>
+
+// Defaults of the SimConfig tunables
+#define SHOT_SQUARE_SIZE 10
+#define SHOT_SPEED 10
+#define PLAYER_SPRITE_OFFSET -90
+#define SHOT_FRAMES_LIFESPAN 180
+#define PLAYER_SHOT_COOLDOWN_FRAMES 60
+#define PLAYER_INVENCIBILITY_FRAMES 60
+#define PLAYER_SPRITE_ALPHA 1
+#define PLAYER_SPRITE_ALPHA_DELTA 0.05
+#define ASTEROID_SPEED 5
+#define POWERUP_FRAMES_LIFESPAN 180
+#define GENERATION_RATE_POWERUP 500
+#define NUMBER_OF_SHOTS_POWERUP 3
+#define MULTIPLE_SHOT_DEVIATION_DEGREES 15
+#define PLAYER_POWERUP_LIFESPAN 500
+#define BROADPHASE_CELL_SIZE 64
+#define ASTEROIDS_POOL_CAPACITY 1024
+#define SHOTS_POOL_CAPACITY 256
+#define STRESS_SHOTS_POOL_CAPACITY 1024
+#define MAX_WORLD_SIZE 65536.0f             // Keeps the broadphase grid at most 1024x1024 cells
+#define MAX_POOL_CAPACITY (1 << 24)
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Same test as raylib CheckCollisionRecs(), kept here so the core never links raylib
+static bool checkCollisionRecs(Rectangle rec1, Rectangle rec2)
+{
+    return ((rec1.x < (rec2.x + rec2.width) && (rec1.x + rec1.width) > rec2.x) &&
+            (rec1.y < (rec2.y + rec2.height) && (rec1.y + rec1.height) > rec2.y));
+}
+
+static Vector2 generateRandomPositionInScreen(GameState *state)
+{
+    int width = (int)state->config.worldWidth;
+    int height = (int)state->config.worldHeight;
+    Vector2 aux = { 0,0 };
+
+    aux.x = GetPrngBounded(&state->rng, width) + 1 - width / 100;
+    aux.y = GetPrngBounded(&state->rng, height) + 1 - height / 100;
+
+    return aux;
+}
+
+// Uniform in [0, worldWidth) x [0, worldHeight), the wrap range every moved entity stays in
+static Vector2 generateRandomPositionInWorld(GameState *state)
+{
+    Vector2 aux = { 0,0 };
+
+    aux.x = (float)GetPrngBounded(&state->rng, (int)state->config.worldWidth);
+    aux.y = (float)GetPrngBounded(&state->rng, (int)state->config.worldHeight);
+
+    return aux;
+}
+
+static Vector2 generateRandomPositionInScreenEdge(GameState *state)
+{
+    //Positions only at the edge to avoid spawns inside the player on startup
+    Vector2 aux = { 0,0 };
+    if (GetPrngBounded(&state->rng, 2) + 1 == 2)
+    {
+        aux.x = 0;
+        aux.y = GetPrngBounded(&state->rng, (int)state->config.worldHeight) + 1;
+    }
+    else
+    {
+        aux.x = GetPrngBounded(&state->rng, (int)state->config.worldWidth) + 1;
+        aux.y = 0;
+    }
+    return aux;
+}
+
+static int generateRandomRotationDegrees(GameState *state)
+{
+    return GetPrngBounded(&state->rng, 360) + 1;
+}
+
+static void generatePowerUp(GameState *state)
+{
+    PlayerPowerUp &powerUp = state->powerUp;
+
+    powerUp.position = generateRandomPositionInScreen(state);
+    powerUp.bounds = { powerUp.position.x, powerUp.position.y, state->config.powerUpSize.x, state->config.powerUpSize.y };
+
+    powerUp.frameslifespan = state->config.powerUpFramesLifespan;
+    powerUp.isActive = true;
+}
+
+static void generateRandomAsteroid(GameState *state, int instances, Vector2 position, int size)
+{
+    Vector2 asteroidSize = state->config.asteroidSizes[size];
+
+    for (int i = 0; i < instances; i++)
+    {
+        //Asteroids never turn, so their velocity is computed once here
+        float rotationDegrees = generateRandomRotationDegrees(state);
+        SpawnAsteroid(&state->asteroids, position, rotationDegrees, GetHeadingVector(rotationDegrees, state->config.asteroidSpeed), size, asteroidSize.x, asteroidSize.y);
+    }
+}
+
+static void generateRandomAsteroid(GameState *state, int instances)
+{
+    generateRandomAsteroid(state, instances, generateRandomPositionInScreenEdge(state), 3);
+}
+
+// Stress fields cover the whole world with every size, not only big asteroids at the edges
+static void generateStressAsteroids(GameState *state, int instances)
+{
+    for (int i = 0; i < instances; i++)
+    {
+        generateRandomAsteroid(state, 1, generateRandomPositionInWorld(state), GetPrngBounded(&state->rng, 3) + 1);
+    }
+}
+
+static void initializePlayer(GameState *state)
+{
+    Player &player = state->player;
+
+    player.position = { state->config.worldWidth/2, state->config.worldHeight/2 };
+    player.previousPosition = player.position;
+    player.previousRotationDegrees = 0;
+    player.rotationDegrees = 0;
+    player.heading = GetHeadingVector(player.rotationDegrees + PLAYER_SPRITE_OFFSET, 1.0f);
+    player.rotationAlpha = 10.0f;
+    player.currentSpeed = 0.0f;
+    player.speedAlpha = 5.0f;
+    player.decelerationRate = 0.1f;
+    player.currentInput = { 0,0 };
+    player.bounds = { player.position.x, player.position.y, state->config.playerSize.x, state->config.playerSize.y };
+    player.lives = 3;
+    player.score = 0;
+    player.isShootInCooldown = false;
+    player.lastShootFrameNumber = 0;
+    player.isShootingKeyActive = false;
+    player.lastDamageFrameCounter = 0;
+    player.spriteAlpha = PLAYER_SPRITE_ALPHA;
+    player.isInvulnerable = false;
+    player.hasPowerUp = false;
+    player.powerUpFramesLeft = 0;
+}
+
+static void movePlayerForwards(GameState *state, float speed)
+{
+    Player &player = state->player;
+    Vector2 velocity = { speed*player.heading.x, speed*player.heading.y };
+
+    MoveAndWrapEntities(&player.position.x, &player.position.y, &velocity.x, &velocity.y, &player.bounds, 1, state->config.worldWidth, state->config.worldHeight);
+}
+
+static void handlePlayerInputs(GameState *state, SimInput input)
+{
+    PROFILE_SCOPE("handlePlayerInputs");
+
+    Player &player = state->player;
+
+    //We store the inputs as a 2D array
+    player.currentInput.y = (float)input.rotation;
+    player.currentInput.x = (float)input.thrust;
+
+    if (input.thrust > 0) player.currentSpeed = player.speedAlpha;
+    else if (input.thrust < 0) player.currentSpeed = -player.speedAlpha;
+
+    player.isShootingKeyActive = input.shoot || (state->config.stressAsteroidCount > 0);
+
+    if (input.quit) state->isFinished = true;
+}
+
+static void handleCollisionsAsteroidPlayer(GameState *state)
+{
+    Player &player = state->player;
+
+    if (state->framesCounter - player.lastDamageFrameCounter >= state->config.playerInvencibilityFrames)
+    {
+        //Stress runs only measure frame cost, the player takes hits but never runs out of lives
+        if (state->config.stressAsteroidCount == 0)
+        {
+            if (player.lives == 1)
+            {
+                state->isFinished = true;
+                state->events |= SIM_EVENT_GAME_OVER;
+            }
+
+            player.lives--;
+        }
+
+        player.lastDamageFrameCounter = state->framesCounter;
+        player.isInvulnerable = true;
+        state->events |= SIM_EVENT_PLAYER_DAMAGED;
+    }
+}
+
+static void handleCollisionsPowerUpPlayer(GameState *state)
+{
+    PlayerPowerUp &powerUp = state->powerUp;
+    Player &player = state->player;
+
+    if (powerUp.isActive && checkCollisionRecs(powerUp.bounds, player.bounds))
+    {
+        player.hasPowerUp = true;
+        powerUp.isActive = false;
+        player.powerUpFramesLeft = state->config.playerPowerUpLifespan;
+        state->events |= SIM_EVENT_POWERUP_PICKED;
+    }
+}
+
+// Broadphase area of a centered shape of the given radius moving by motion over the tick, grown so
+// the grid (built from bounds anchored at the asteroid position) returns every asteroid it can touch
+static Rectangle getShapeQueryArea(const GameState *state, Vector2 center, Vector2 motion, float radius)
+{
+    float margin = radius + state->maxAsteroidRadius + fabsf(state->config.asteroidSpeed);
+
+    float minX = std::min(center.x, center.x - motion.x) - margin;
+    float minY = std::min(center.y, center.y - motion.y) - margin;
+    float maxX = std::max(center.x, center.x - motion.x) + margin;
+    float maxY = std::max(center.y, center.y - motion.y) + margin;
+
+    return { minX, minY, maxX - minX, maxY - minY };
+}
+
+// Pairs a shot path over the last tick with every candidate asteroid path, both started one velocity back
+static void pushShotPairs(GameState *state, int shot, const std::vector<int> &candidates)
+{
+    const AsteroidStore &asteroids = state->asteroids;
+    const ShotStore &shots = state->shots;
+    float shotRadius = state->config.shotSize/2;
+    Vector2 shotStart = { shots.positionX[shot] + shotRadius - shots.velocityX[shot], shots.positionY[shot] + shotRadius - shots.velocityY[shot] };
+
+    for (int asteroid : candidates)
+    {
+        if (!asteroids.isActive[asteroid]) continue;
+
+        int size = asteroids.size[asteroid];
+        Vector2 offset = { shotStart.x - (asteroids.positionX[asteroid] - asteroids.velocityX[asteroid]), shotStart.y - (asteroids.positionY[asteroid] - asteroids.velocityY[asteroid]) };
+        Vector2 motion = { shots.velocityX[shot] - asteroids.velocityX[asteroid], shots.velocityY[shot] - asteroids.velocityY[asteroid] };
+
+        PushCollisionPair(&state->collisionPairs, shot, asteroid, offset, motion, shotRadius + state->config.asteroidShapes[size].radius, asteroids.rotationDegrees[asteroid], size);
+    }
+}
+
+static void handleCollisionsAsteroidShot(GameState *state, int asteroid, int shot)
+{
+    AsteroidStore &asteroids = state->asteroids;
+    ShotStore &shots = state->shots;
+    Player &player = state->player;
+
+    Vector2 asteroidPosition = { asteroids.positionX[asteroid], asteroids.positionY[asteroid] };
+    state->hits.push_back({ asteroidPosition, asteroids.size[asteroid] });
+
+    if (asteroids.size[asteroid] == 3)
+    {
+        asteroids.size[asteroid] = 2;
+        player.score += 10;
+        generateRandomAsteroid(state, 3, asteroidPosition, 2);
+    }
+    else if (asteroids.size[asteroid] == 2)
+    {
+        asteroids.size[asteroid] = 1;
+        player.score += 20;
+        generateRandomAsteroid(state, 3, asteroidPosition, 1);
+    }
+    else if (asteroids.size[asteroid] == 1)
+    {
+        player.score += 30;
+    }
+
+    asteroids.isActive[asteroid] = false;
+    shots.isActive[shot] = false;
+    state->events |= SIM_EVENT_ASTEROID_HIT;
+}
+
+// Differential check: every asteroid whose swept circle reaches the shot path must be a broadphase candidate
+// NOTE: Brute force over every asteroid and allocating, only runs when isVerifyingBroadphase is set
+static void verifyBroadphaseCandidates(GameState *state, int shot, const std::vector<int> &candidates)
+{
+    std::vector<int> everyAsteroid;
+    CollisionPairs everyPair = { };
+
+    everyAsteroid.resize(GetAsteroidCount(state->asteroids));
+    for (int i = 0; i < (int)everyAsteroid.size(); i++) everyAsteroid[i] = i;
+
+    std::swap(everyPair, state->collisionPairs);
+    state->collisionPairs.count = 0;
+    pushShotPairs(state, shot, everyAsteroid);
+    RejectCollisionCircles(&state->collisionPairs);
+    std::swap(everyPair, state->collisionPairs);
+
+    for (int i = 0; i < everyPair.count; i++)
+    {
+        int asteroid = everyPair.second[i];
+        if (!std::binary_search(candidates.begin(), candidates.end(), asteroid))
+        {
+            fprintf(stderr, "BROADPHASE: Missed pair, frame %i, shot %i, asteroid %i at (%.2f, %.2f)\n", state->framesCounter, shot, asteroid, state->asteroids.positionX[asteroid], state->asteroids.positionY[asteroid]);
+            state->broadphaseMisses++;
+        }
+    }
+}
+
+static void handleShotsCollisions(GameState *state)
+{
+    PROFILE_SCOPE("handleShotsCollisions");
+
+    const ShotStore &shots = state->shots;
+    CollisionPairs &pairs = state->collisionPairs;
+    float shotRadius = state->config.shotSize/2;
+
+    //Broadphase: only asteroids sharing a grid cell with the shot path become candidate pairs
+    BuildSpatialGrid(&state->asteroidsGrid, state->asteroids.bounds.data(), GetAsteroidCount(state->asteroids));
+    pairs.count = 0;
+
+    for (int shot = 0; shot < GetShotCount(shots); shot++)
+    {
+        if (!shots.isActive[shot]) continue;
+
+        Vector2 center = { shots.positionX[shot] + shotRadius, shots.positionY[shot] + shotRadius };
+        Vector2 motion = { shots.velocityX[shot], shots.velocityY[shot] };
+        QuerySpatialGrid(&state->asteroidsGrid, getShapeQueryArea(state, center, motion, shotRadius), &state->broadphaseCandidates);
+
+        if (state->isVerifyingBroadphase) verifyBroadphaseCandidates(state, shot, state->broadphaseCandidates);
+        pushShotPairs(state, shot, state->broadphaseCandidates);
+    }
+
+    //Narrow phase: circle reject, then the shot circle swept through the rotated asteroid polygon
+    RejectCollisionCircles(&pairs);
+    SweepCircleAgainstShapes(&pairs, shotRadius, state->config.asteroidShapes);
+
+    //Pairs are grouped by shot in shot order, a shot stops at the first live asteroid on its path
+    //(ties go to the lowest index, candidates come sorted)
+    for (int begin = 0; begin < pairs.count; )
+    {
+        int shot = pairs.first[begin];
+        int hitAsteroid = -1;
+        float hitTime = 2.0f;
+        int end = begin;
+
+        for (; (end < pairs.count) && (pairs.first[end] == shot); end++)
+        {
+            int asteroid = pairs.second[end];
+
+            if ((pairs.time[end] >= 0.0f) && (pairs.time[end] < hitTime) && state->asteroids.isActive[asteroid])
+            {
+                hitAsteroid = asteroid;
+                hitTime = pairs.time[end];
+            }
+        }
+
+        if (hitAsteroid != -1) handleCollisionsAsteroidShot(state, hitAsteroid, shot);
+
+        begin = end;
+    }
+}
+
+static void handlePlayerCollisions(GameState *state)
+{
+    PROFILE_SCOPE("handlePlayerCollisions");
+
+    const AsteroidStore &asteroids = state->asteroids;
+    const Player &player = state->player;
+    const SimConfig &config = state->config;
+    CollisionPairs &pairs = state->collisionPairs;
+
+    //Grid from handleShotsCollisions() is still valid, only shot asteroids changed and they still count here
+    QuerySpatialGrid(&state->asteroidsGrid, getShapeQueryArea(state, player.position, { 0, 0 }, config.playerShape.radius), &state->broadphaseCandidates);
+    pairs.count = 0;
+
+    for (int asteroid : state->broadphaseCandidates)
+    {
+        int size = asteroids.size[asteroid];
+        Vector2 offset = { player.position.x - asteroids.positionX[asteroid], player.position.y - asteroids.positionY[asteroid] };
+
+        PushCollisionPair(&pairs, 0, asteroid, offset, { 0, 0 }, config.playerShape.radius + config.asteroidShapes[size].radius, asteroids.rotationDegrees[asteroid], size);
+    }
+
+    //Narrow phase: circle reject, then rotated player polygon against rotated asteroid polygons
+    RejectCollisionCircles(&pairs);
+    OverlapShapeAgainstShapes(&pairs, &config.playerShape, player.rotationDegrees, config.asteroidShapes);
+
+    for (int i = 0; i < pairs.count; i++)
+    {
+        if (pairs.time[i] >= 0.0f) handleCollisionsAsteroidPlayer(state);
+    }
+
+    handleCollisionsPowerUpPlayer(state);
+}
+
+static void generatePlayerShot(GameState *state, bool isPowerUpActive)
+{
+    const Player &player = state->player;
+    const SimConfig &config = state->config;
+
+    SpawnShot(&state->shots, player.position, player.rotationDegrees, GetHeadingVector(player.rotationDegrees + PLAYER_SPRITE_OFFSET, config.shotSpeed), config.shotSize, config.shotFramesLifespan);
+
+    if (isPowerUpActive)
+    {
+        for (int i = -config.multipleShotDeviationDegrees; i < (config.powerUpShotCount - 1)*config.multipleShotDeviationDegrees; i += config.multipleShotDeviationDegrees*2)
+        {
+            float rotationDegrees = player.rotationDegrees + i;
+            SpawnShot(&state->shots, player.position, rotationDegrees, GetHeadingVector(rotationDegrees + PLAYER_SPRITE_OFFSET, config.shotSpeed), config.shotSize, config.shotFramesLifespan);
+        }
+    }
+
+    //New shots already move this frame
+    CommitPendingShots(&state->shots);
+}
+
+static void handlePlayerMovement(GameState *state)
+{
+    PROFILE_SCOPE("handlePlayerMovement");
+
+    Player &player = state->player;
+
+    player.previousPosition = player.position;
+    player.previousRotationDegrees = player.rotationDegrees;
+
+    //Rotation
+    player.rotationDegrees += player.currentInput.y*player.rotationAlpha;
+    if (player.currentInput.y != 0) player.heading = GetHeadingVector(player.rotationDegrees + PLAYER_SPRITE_OFFSET, 1.0f);
+
+    //Translation
+    movePlayerForwards(state, player.speedAlpha*player.currentInput.x);
+
+    //Gradual deceleration when no movement input is applied
+    if (player.currentInput.x == 0)
+    {
+        if (player.currentSpeed > 0) player.currentSpeed -= player.decelerationRate;
+        if (player.currentSpeed < 0) player.currentSpeed += player.decelerationRate;
+
+        movePlayerForwards(state, player.currentSpeed);
+    }
+    else state->events |= SIM_EVENT_THRUST;
+
+    if (state->framesCounter - player.lastDamageFrameCounter >= state->config.playerInvencibilityFrames && player.lastDamageFrameCounter != 0)
+    {
+        player.isInvulnerable = false;
+        player.spriteAlpha = 1;
+    }
+
+    if (player.isInvulnerable)
+    {
+        player.spriteAlpha -= PLAYER_SPRITE_ALPHA_DELTA;
+        if (player.spriteAlpha <= 0) player.spriteAlpha = 1;
+    }
+
+    //We allow the player to shoot again if the cooldown time has passed
+    if (state->framesCounter - player.lastShootFrameNumber >= state->config.playerShotCooldownFrames || player.lastShootFrameNumber == 0)
+    {
+        player.isShootInCooldown = false;
+    }
+
+    //Player shot logic
+    if (player.isShootingKeyActive && !player.isShootInCooldown)
+    {
+        generatePlayerShot(state, player.hasPowerUp);
+        player.isShootInCooldown = true;
+        player.lastShootFrameNumber = state->framesCounter;
+        state->events |= SIM_EVENT_SHOT;
+    }
+
+    if (player.hasPowerUp)
+    {
+        if (player.powerUpFramesLeft > 0) player.powerUpFramesLeft--;
+        else player.hasPowerUp = false;
+    }
+}
+
+static void handleAsteroidsMovement(GameState *state)
+{
+    PROFILE_SCOPE("handleAsteroidsMovement");
+
+    AsteroidStore &asteroids = state->asteroids;
+
+    MoveAndWrapEntities(asteroids.positionX.data(), asteroids.positionY.data(), asteroids.velocityX.data(), asteroids.velocityY.data(),
+                        asteroids.bounds.data(), GetAsteroidCount(asteroids), state->config.worldWidth, state->config.worldHeight);
+}
+
+static void handleShotsMovement(GameState *state)
+{
+    PROFILE_SCOPE("handleShotsMovement");
+
+    ShotStore &shots = state->shots;
+
+    MoveAndWrapEntities(shots.positionX.data(), shots.positionY.data(), shots.velocityX.data(), shots.velocityY.data(),
+                        shots.bounds.data(), GetShotCount(shots), state->config.worldWidth, state->config.worldHeight);
+
+    for (int i = 0; i < GetShotCount(shots); i++)
+    {
+        shots.framesLifespan[i]--;
+
+        //Expired shots can not hit anything, they are removed in checkElementsToRemove
+        if (shots.framesLifespan[i] <= 0) shots.isActive[i] = false;
+    }
+}
+
+static void handleNumberOfAsteroids(GameState *state)
+{
+    PROFILE_SCOPE("handleNumberOfAsteroids");
+
+    int stressCount = state->config.stressAsteroidCount;
+
+    if (stressCount > 0)
+    {
+        //Top the field back up, splits can push it above the target until the pool is full
+        int asteroidCount = GetAsteroidCount(state->asteroids) + state->asteroids.slots.pendingCount;
+        if (asteroidCount < stressCount) generateStressAsteroids(state, stressCount - asteroidCount);
+    }
+    else if (GetAsteroidCount(state->asteroids) == 0)
+    {
+        generateRandomAsteroid(state, GetPrngBounded(&state->rng, 4) + 1);
+    }
+
+    CommitPendingAsteroids(&state->asteroids);
+}
+
+static void checkElementsToRemove(GameState *state)
+{
+    PROFILE_SCOPE("checkElementsToRemove");
+
+    //Single swap-remove pass per pool, entity order is not preserved
+    CompactAsteroids(&state->asteroids);
+    CompactShots(&state->shots);
+}
+
+static void handlePowerUp(GameState *state)
+{
+    PROFILE_SCOPE("handlePowerUp");
+
+    PlayerPowerUp &powerUp = state->powerUp;
+
+    //Chance of 50% after powerUpGenerationRate number of frames
+    if (!powerUp.isActive && GetPrngBounded(&state->rng, 2) + 1 == 2 && state->framesCounter % state->config.powerUpGenerationRate == 0)
+    {
+        generatePowerUp(state);
+    }
+
+    if (powerUp.isActive)
+    {
+        if (powerUp.frameslifespan > 0) powerUp.frameslifespan--;
+        else powerUp.isActive = false;
+    }
+}
+
+// FNV-1a, fed field by field so struct padding never reaches the hash
+static uint32_t hashBytes(uint32_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+template <typename T>
+static uint32_t hashValue(uint32_t hash, const T &value)
+{
+    return hashBytes(hash, &value, sizeof(T));
+}
+
+template <typename T>
+static uint32_t hashArray(uint32_t hash, const std::vector<T> &values, int count)
+{
+    return hashBytes(hash, values.data(), count*sizeof(T));
+}
+
+static bool isSizeValid(float value)
+{
+    return (value > 0.0f) && (value <= MAX_WORLD_SIZE);     // False for NaN too
+}
+
+static bool isShapeValid(const CollisionShape &shape)
+{
+    if ((shape.vertexCount < 3) || (shape.vertexCount > COLLISION_SHAPE_MAX_VERTICES) || !isSizeValid(shape.radius)) return false;
+
+    for (int i = 0; i < shape.vertexCount; i++)
+    {
+        if (!isfinite(shape.vertices[i].x) || !isfinite(shape.vertices[i].y)) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+SimConfig GetDefaultSimConfig(void)
+{
+    SimConfig config = { 0 };
+
+    config.worldWidth = 1280.0f;
+    config.worldHeight = 720.0f;
+    config.playerSize = { 48.0f, 48.0f };             // SpaceShip.png
+    config.asteroidSizes[1] = { 32.0f, 32.0f };       // SmallMeteor.png
+    config.asteroidSizes[2] = { 42.0f, 42.0f };       // MendiumMeteor.png
+    config.asteroidSizes[3] = { 86.0f, 64.0f };       // BigMeteor.png
+    config.powerUpSize = { 32.0f, 32.0f };            // Bonus.png
+    config.playerShape = GenCollisionShapeBox(config.playerSize.x, config.playerSize.y);
+    for (int size = 1; size < 4; size++) config.asteroidShapes[size] = GenCollisionShapeBox(config.asteroidSizes[size].x, config.asteroidSizes[size].y);
+    config.asteroidCapacity = ASTEROIDS_POOL_CAPACITY;
+    config.shotCapacity = SHOTS_POOL_CAPACITY;
+
+    config.asteroidSpeed = ASTEROID_SPEED;
+    config.shotSpeed = SHOT_SPEED;
+    config.shotSize = SHOT_SQUARE_SIZE;
+    config.shotFramesLifespan = SHOT_FRAMES_LIFESPAN;
+    config.playerShotCooldownFrames = PLAYER_SHOT_COOLDOWN_FRAMES;
+    config.playerInvencibilityFrames = PLAYER_INVENCIBILITY_FRAMES;
+    config.playerPowerUpLifespan = PLAYER_POWERUP_LIFESPAN;
+    config.powerUpFramesLifespan = POWERUP_FRAMES_LIFESPAN;
+    config.powerUpGenerationRate = GENERATION_RATE_POWERUP;
+    config.powerUpShotCount = NUMBER_OF_SHOTS_POWERUP;
+    config.multipleShotDeviationDegrees = MULTIPLE_SHOT_DEVIATION_DEGREES;
+
+    return config;
+}
+
+// Every shot alive can split one asteroid into three per tick, so the pool keeps that much headroom
+void SetSimConfigStress(SimConfig *config, int asteroidCount)
+{
+    config->stressAsteroidCount = asteroidCount;
+    config->shotCapacity = STRESS_SHOTS_POOL_CAPACITY;
+    config->asteroidCapacity = asteroidCount + 3*STRESS_SHOTS_POOL_CAPACITY;
+    config->playerShotCooldownFrames = 1;
+}
+
+bool IsSimConfigValid(const SimConfig *config)
+{
+    if (!isSizeValid(config->worldWidth) || !isSizeValid(config->worldHeight)) return false;
+    if (!isSizeValid(config->playerSize.x) || !isSizeValid(config->playerSize.y)) return false;
+    if (!isSizeValid(config->powerUpSize.x) || !isSizeValid(config->powerUpSize.y)) return false;
+    if (!isShapeValid(config->playerShape)) return false;
+
+    for (int size = 1; size < 4; size++)
+    {
+        if (!isSizeValid(config->asteroidSizes[size].x) || !isSizeValid(config->asteroidSizes[size].y)) return false;
+        if (!isShapeValid(config->asteroidShapes[size])) return false;
+    }
+
+    if ((config->asteroidCapacity < 1) || (config->asteroidCapacity > MAX_POOL_CAPACITY)) return false;
+    if ((config->shotCapacity < 1) || (config->shotCapacity > MAX_POOL_CAPACITY)) return false;
+
+    // Speeds move something every tick, durations and counts may be zero, the power-up rate divides
+    if (!isSizeValid(config->asteroidSpeed) || !isSizeValid(config->shotSpeed) || !isSizeValid(config->shotSize)) return false;
+    if ((config->shotFramesLifespan < 0) || (config->playerShotCooldownFrames < 0) || (config->playerInvencibilityFrames < 0)) return false;
+    if ((config->playerPowerUpLifespan < 0) || (config->powerUpFramesLifespan < 0) || (config->powerUpGenerationRate < 1)) return false;
+    if ((config->powerUpShotCount < 0) || (config->powerUpShotCount > config->shotCapacity)) return false;
+    if ((config->multipleShotDeviationDegrees < 0) || (config->multipleShotDeviationDegrees > 360)) return false;
+    if ((config->stressAsteroidCount < 0) || (config->stressAsteroidCount > config->asteroidCapacity)) return false;
+
+    return true;
+}
+
+void InitSimulation(GameState *state, const SimConfig *config, uint64_t seed)
+{
+    state->config = *config;
+    state->seed = seed;
+    SeedPrng(&state->rng, seed);
+    state->framesCounter = 0;
+    state->isFinished = false;
+    state->events = 0;
+    state->isVerifyingBroadphase = false;
+    state->broadphaseMisses = 0;
+
+    initializePlayer(state);
+
+    //Every gameplay container is sized here so steps do not allocate
+    InitAsteroids(&state->asteroids, config->asteroidCapacity);
+    InitShots(&state->shots, config->shotCapacity);
+    InitSpatialGrid(&state->asteroidsGrid, config->worldWidth, config->worldHeight, BROADPHASE_CELL_SIZE, config->asteroidCapacity);
+    state->broadphaseCandidates.clear();
+    state->broadphaseCandidates.reserve(config->asteroidCapacity);
+    ReserveCollisionPairs(&state->collisionPairs, config->asteroidCapacity);
+    state->hits.clear();
+    state->hits.reserve(config->shotCapacity);     // A shot destroys one asteroid at most
+
+    state->maxAsteroidRadius = 0.0f;
+    for (int size = 1; size < 4; size++) state->maxAsteroidRadius = std::max(state->maxAsteroidRadius, config->asteroidShapes[size].radius);
+
+    //Initializing asteroids
+    if (config->stressAsteroidCount > 0) generateStressAsteroids(state, config->stressAsteroidCount);
+    else generateRandomAsteroid(state, GetPrngBounded(&state->rng, 2) + 1);
+    CommitPendingAsteroids(&state->asteroids);
+
+    state->powerUp.position = { 0, 0 };
+    state->powerUp.isActive = false;
+    state->powerUp.frameslifespan = 0;
+    state->powerUp.bounds = { 0, 0, config->powerUpSize.x, config->powerUpSize.y };
+}
+
+void UnloadSimulation(GameState *state)
+{
+    ClearAsteroids(&state->asteroids);
+    ClearShots(&state->shots);
+}
+
+void StepSimulation(GameState *state, SimInput input)
+{
+    PROFILE_SCOPE("StepSimulation");
+
+    state->events = 0;
+    state->hits.clear();
+
+    handlePlayerInputs(state, input);
+    handlePlayerMovement(state);
+    handleShotsMovement(state);
+    handlePowerUp(state);
+    handleAsteroidsMovement(state);
+    handleShotsCollisions(state);
+    handlePlayerCollisions(state);
+    handleNumberOfAsteroids(state);
+    checkElementsToRemove(state);
+
+    state->framesCounter++;
+}
+
+uint32_t GetSimulationHash(const GameState *state)
+{
+    const Player &player = state->player;
+    const AsteroidStore &asteroids = state->asteroids;
+    const ShotStore &shots = state->shots;
+    uint32_t hash = 2166136261u;
+
+    hash = hashValue(hash, state->framesCounter);
+    hash = hashValue(hash, state->rng.state);
+
+    hash = hashValue(hash, player.position);
+    hash = hashValue(hash, player.rotationDegrees);
+    hash = hashValue(hash, player.currentSpeed);
+    hash = hashValue(hash, player.lives);
+    hash = hashValue(hash, player.score);
+    hash = hashValue(hash, player.lastShootFrameNumber);
+    hash = hashValue(hash, player.lastDamageFrameCounter);
+    hash = hashValue(hash, player.powerUpFramesLeft);
+
+    hash = hashValue(hash, state->powerUp.position);
+    hash = hashValue(hash, state->powerUp.frameslifespan);
+
+    int asteroidCount = GetAsteroidCount(asteroids);
+    hash = hashValue(hash, asteroidCount);
+    hash = hashArray(hash, asteroids.positionX, asteroidCount);
+    hash = hashArray(hash, asteroids.positionY, asteroidCount);
+    hash = hashArray(hash, asteroids.velocityX, asteroidCount);
+    hash = hashArray(hash, asteroids.velocityY, asteroidCount);
+    hash = hashArray(hash, asteroids.size, asteroidCount);
+
+    int shotCount = GetShotCount(shots);
+    hash = hashValue(hash, shotCount);
+    hash = hashArray(hash, shots.positionX, shotCount);
+    hash = hashArray(hash, shots.positionY, shotCount);
+    hash = hashArray(hash, shots.framesLifespan, shotCount);
+
+    return hash;
+}
+
+float GetSimulationTime(const GameState *state)
+{
+    return (float)state->framesCounter/SIM_TICKS_PER_SECOND;
+}
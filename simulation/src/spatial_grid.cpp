@@ -0,0 +1,136 @@
+/**********************************************************************************************
+*
+*   Spatial Grid - Uniform grid broadphase for a screen-wrapped world
+*
+**********************************************************************************************/
+
+#include "spatial_grid.h"
+#include <math.h>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition (local)
+//----------------------------------------------------------------------------------
+
+// Wrap a cell coordinate into [0, cells), also valid for negative coordinates
+static int WrapCell(int cell, int cells)
+{
+    int wrapped = cell%cells;
+
+    return (wrapped < 0)? wrapped + cells : wrapped;
+}
+
+// Get the unwrapped cell span covered by [min, max], clamped so no cell is visited twice
+static void GetCellSpan(float min, float max, float cellSize, int cells, int *first, int *count)
+{
+    int firstCell = (int)floorf(min/cellSize);
+    int lastCell = (int)floorf(max/cellSize);
+
+    *first = firstCell;
+    *count = std::min(lastCell - firstCell + 1, cells);
+}
+
+//----------------------------------------------------------------------------------
+// Spatial Grid Functions Definition
+//----------------------------------------------------------------------------------
+
+// Initialize grid so cells tile the world exactly, cellSize is only a target size
+// NOTE: Memory is reserved for itemCapacity items so rebuilding the grid does not allocate
+void InitSpatialGrid(SpatialGrid *grid, float worldWidth, float worldHeight, float cellSize, int itemCapacity)
+{
+    grid->columns = std::max(1, (int)(worldWidth/cellSize));
+    grid->rows = std::max(1, (int)(worldHeight/cellSize));
+    grid->cellWidth = worldWidth/grid->columns;
+    grid->cellHeight = worldHeight/grid->rows;
+
+    grid->cellStart.assign(grid->columns*grid->rows + 1, 0);
+    grid->cellCursor.assign(grid->columns*grid->rows, 0);
+    grid->cellItems.clear();
+    grid->cellItems.reserve(itemCapacity*9);   // Items up to a cell in size span at most 3x3 cells
+    grid->queryStamp.clear();
+    grid->queryStamp.reserve(itemCapacity);
+    grid->queryCounter = 0;
+}
+
+// Bucket all items into the cells their bounds overlap (counting sort, two passes)
+void BuildSpatialGrid(SpatialGrid *grid, const Rectangle *bounds, int count)
+{
+    std::fill(grid->cellStart.begin(), grid->cellStart.end(), 0);
+
+    // First pass: count items per cell
+    for (int i = 0; i < count; i++)
+    {
+        int firstColumn, columnCount, firstRow, rowCount;
+        GetCellSpan(bounds[i].x, bounds[i].x + bounds[i].width, grid->cellWidth, grid->columns, &firstColumn, &columnCount);
+        GetCellSpan(bounds[i].y, bounds[i].y + bounds[i].height, grid->cellHeight, grid->rows, &firstRow, &rowCount);
+
+        for (int r = 0; r < rowCount; r++)
+        {
+            int row = WrapCell(firstRow + r, grid->rows);
+            for (int c = 0; c < columnCount; c++) grid->cellStart[row*grid->columns + WrapCell(firstColumn + c, grid->columns) + 1]++;
+        }
+    }
+
+    for (int cell = 0; cell < grid->columns*grid->rows; cell++)
+    {
+        grid->cellStart[cell + 1] += grid->cellStart[cell];
+        grid->cellCursor[cell] = grid->cellStart[cell];
+    }
+
+    grid->cellItems.resize(grid->cellStart[grid->columns*grid->rows]);
+
+    // Second pass: store item indices, every cell ends up sorted since items are visited in order
+    for (int i = 0; i < count; i++)
+    {
+        int firstColumn, columnCount, firstRow, rowCount;
+        GetCellSpan(bounds[i].x, bounds[i].x + bounds[i].width, grid->cellWidth, grid->columns, &firstColumn, &columnCount);
+        GetCellSpan(bounds[i].y, bounds[i].y + bounds[i].height, grid->cellHeight, grid->rows, &firstRow, &rowCount);
+
+        for (int r = 0; r < rowCount; r++)
+        {
+            int row = WrapCell(firstRow + r, grid->rows);
+            for (int c = 0; c < columnCount; c++) grid->cellItems[grid->cellCursor[row*grid->columns + WrapCell(firstColumn + c, grid->columns)]++] = i;
+        }
+    }
+
+    grid->queryStamp.assign(count, 0);
+    grid->queryCounter = 0;
+}
+
+// Collect every item sharing at least one cell with area, sorted ascending without duplicates
+// NOTE: Candidates are a superset of the real overlaps, an exact test is still required
+int QuerySpatialGrid(SpatialGrid *grid, Rectangle area, std::vector<int> *result)
+{
+    result->clear();
+    grid->queryCounter++;
+
+    int firstColumn, columnCount, firstRow, rowCount;
+    GetCellSpan(area.x, area.x + area.width, grid->cellWidth, grid->columns, &firstColumn, &columnCount);
+    GetCellSpan(area.y, area.y + area.height, grid->cellHeight, grid->rows, &firstRow, &rowCount);
+
+    for (int r = 0; r < rowCount; r++)
+    {
+        int row = WrapCell(firstRow + r, grid->rows);
+
+        for (int c = 0; c < columnCount; c++)
+        {
+            int cell = row*grid->columns + WrapCell(firstColumn + c, grid->columns);
+
+            for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++)
+            {
+                int item = grid->cellItems[k];
+
+                if (grid->queryStamp[item] != grid->queryCounter)
+                {
+                    grid->queryStamp[item] = grid->queryCounter;
+                    result->push_back(item);
+                }
+            }
+        }
+    }
+
+    // Keep brute-force visiting order so hit resolution does not depend on cell layout
+    std::sort(result->begin(), result->end());
+
+    return (int)result->size();
+}